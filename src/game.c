@@ -1,13 +1,37 @@
+#define _GNU_SOURCE // for clock_gettime(), sysconf(), sched_setaffinity()
+ 
 #include <stdio.h>
 #include <stdlib.h>
-#include <ctype.h>  // for touppper()
+#include <stdint.h>
+#include <string.h>   // for memset(), strcmp()
+#include <ctype.h>    // for touppper(), isdigit()
+#include <math.h>     // for expf(), logf()
+#include <time.h>     // for clock_gettime()
+#include <unistd.h>   // for sysconf(), dup2(), isatty()
+#include <fcntl.h>    // for open()
+#include <errno.h>    // for errno
+#include <sched.h>    // for sched_setaffinity()
+#include <sys/mman.h> // for mmap()
+#include <sys/stat.h> // for fstat()
+#include <pthread.h>
+ 
+#if defined(ENABLE_PROFILING) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h> // for __rdtsc()
+#endif
  
-// Constants
+// Constants (the board size and amount of pieces can be changed when compiling, ex. -DROW=8)
+#ifndef ROW
 #define ROW           7
+#endif
+#ifndef COL
 #define COL           5
+#endif
 #define ROW_INIT      (ROW + 1)
 #define COL_INIT      (COL + 1)
+#ifndef MAX_POS_AMT
 #define MAX_POS_AMT   5
+#endif
+#define MAX_MOVE_AMT  (MAX_POS_AMT * 3) // each piece has at most 3 moves
  
 // Marks
 #define ALPHA_MARK   'X'
@@ -19,12 +43,157 @@
 #define ALPHA_WIN      1
 #define BETA_WIN       2
  
+// Input
+#define INPUT_LINE_LEN   256   // longest line of input that is parsed
+#define INPUT_POS_AMT    64    // most positions that can be entered in one line
+ 
+// Search
+#ifndef MAX_PLY
+#define MAX_PLY        64      // no game can last longer (pieces only move forward)
+#endif
+#define WIN_SCORE      100000  // score of a won position at ply 0
+#define INF_SCORE      (WIN_SCORE + MAX_PLY + 1)
+#define FEATURE_AMT    4       // amount of features used by evaluatePosition()
+#define TT_EXACT       1       // the stored score is exact
+#define TT_LOWER       2       // the stored score is a lower bound
+#define TT_UPPER       3       // the stored score is an upper bound
+ 
+// Shared transposition tables (see openSharedTransTable())
+#define SHARED_TABLE_MAGIC       0x454C424154414753ULL // "SGATABLE"
+#define SHARED_TABLE_VERSION     2
+#define SHARED_TABLE_HEADER_SIZE 4096   // header before the slots, a page so the slots stay aligned
+#define SHARED_TABLE_WAIT_AMT    1000   // milliseconds to wait for another process to set up a table
+ 
+// Packed positions (see packPos())
+#define PACKED_OWNER_SHIFT    (ROW * COL)
+#define PACKED_PLAYER_SHIFT   (PACKED_OWNER_SHIFT + 2 * MAX_POS_AMT)
+#define PACKED_BOARD_MASK     ((1ULL << PACKED_OWNER_SHIFT) - 1)
+ 
+// Self-play and tuning
+#define ARCHIVE_MAGIC        "SCGA"  // first bytes of a game archive
+#define ARCHIVE_VERSION      2       // byte after the magic (see writeArchiveHeader())
+#define ARCHIVE_HEADER_SIZE  10      // bytes before the first game: magic, version, board size and rules
+#define MAX_THREAD_AMT       256
+#define SELFPLAY_RANDOM_PLY  4       // plies played randomly at the start of a self-play game
+#define SELFPLAY_RANDOM_PCT  10      // chance (in percent) of a random move afterwards
+#define TUNE_BLOCK_AMT       1024    // positions processed at a time by each tuning thread
+#define TUNE_SCALE           100.0f  // evaluation score that maps to a logit of 1
+#define TUNE_RATE            1.0     // learning rate of the tuner
+ 
+// Archive validation (see validateGame())
+#define VALIDATE_CHUNK_AMT       4096   // games validated at a time by each thread
+#define VERDICT_OK               0      // the game is valid
+#define VERDICT_BAD_CODE         1      // a move leaves the game board
+#define VERDICT_NOT_OWN_PIECE    2      // a move does not move a current player's piece
+#define VERDICT_ILLEGAL_MOVE     3      // a move is not one square forward
+#define VERDICT_OWN_CAPTURE      4      // a move lands on a current player's piece
+#define VERDICT_NOT_S_SQUARE     5      // a capture is not on an S square
+#define VERDICT_MOVE_AFTER_END   6      // a move is played after the game ended
+#define VERDICT_WRONG_RESULT     7      // the result does not match the game
+#define VERDICT_AMT              8
+ 
+// Archive compression (see compressArchiveBlock())
+#define COMPRESSED_ARCHIVE_MAGIC "SCGR"  // first bytes of a compressed game archive
+#define COMPRESS_BLOCK_AMT       4096    // games compressed with the same model
+#define RANGE_TOP                (1u << 24)
+#define RANGE_BOTTOM             (1u << 16)
+#define MODEL_FREQ_STEP          24      // added to the frequency of a played move
+#define MODEL_FREQ_LIMIT         (1 << 13) // total at which frequencies are halved
+ 
+// Archive statistics (see runStats())
+#define STATS_CHUNK_AMT          4096   // games claimed at a time by each thread
+#define WIN_BY_REACH             0      // the winner's pieces reached the opponent's starting positions
+#define WIN_BY_CAPTURE           1      // the winner captured every piece of the opponent
+#define WIN_BY_NONE              2      // nobody won, since a player had no moves left
+#define WIN_CONDITION_AMT        3
+ 
+// Rule-variant sweep (see runSweep())
+#define SWEEP_MAX_VARIANT_AMT    256
+#define SWEEP_SOLVE_NODE_AMT     2000000 // most nodes the solver may visit per variant
+ 
+// Annotation (see runAnnotator())
+#define ANNOTATE_BEST_MARGIN     10     // most points a move can lose and still be marked best
+#define ANNOTATE_BLUNDER_LOSS    100    // least points a move must lose to be marked a blunder
+ 
+// Proof-number search (see searchProofNumbers())
+#define PN_INF            0x7FFFFFFFu  // proof number of a solved position
+#define PN_UNKNOWN        0            // the limits were reached before solving
+#define PN_WIN            1            // the player to move can force a win
+#define PN_LOSS           2            // the opponent can force a win
+#define PN_DRAW           3            // neither player can force a win
+#define PN_AI_TABLE_MB    16           // node table of the AI player's solver
+#define PN_AI_NODE_AMT    200000       // most nodes the AI player's solver may visit
+#define PN_CHECK_NODE_AMT 1024         // nodes between reads of the clock
+ 
+// Checkpoints (see writeFileAtomically())
+#define CHECKPOINT_VERSION          2
+#define CHECKPOINT_PATH_LEN         4096
+#define CHECKPOINT_HEADER_SIZE      4096    // header of a solver checkpoint, a page so the table can be mapped
+#define CHECKPOINT_POLL_US          100000  // how often self-play checks if its threads are done
+#define DEFAULT_CHECKPOINT_SEC      300     // default time between checkpoints
+#define SOLVER_CHECKPOINT_MAGIC     "SCPN"
+#define SELFPLAY_CHECKPOINT_MAGIC   "SCSP"
+ 
+// Spectator broadcasts (see publishBoard())
+#define BROADCAST_MAGIC          0x5357454956414753ULL // "SGAVIEWS"
+#define BROADCAST_VERSION        2
+#define BROADCAST_SLOT_AMT       64     // diffs kept for spectators that fall behind
+#define BROADCAST_CHANGE_AMT     4      // most squares a diff lists (a move changes 2)
+#define BROADCAST_POLL_US        10000  // how often spectators check for a new move
+#define BROADCAST_NO_MOVES       3      // status after the last move if the player to move has none
+ 
+// Memory
+#define ARENA_ALIGN          16               // alignment of arena allocations
+#define DEFAULT_MEMORY_MB    64               // default budget shared by the threads of a job
+ 
+// Benchmarks
+#define BENCH_POS_AMT        4096    // positions shared by the rules benchmarks
+#define BENCH_RENDER_AMT     20000   // boards displayed by the rendering benchmark
+#define BENCH_GAME_AMT       20000   // games played by the random game benchmark
+#define BENCH_SELFPLAY_AMT   200     // games played by the self-play benchmark
+#define BENCH_REPEAT_AMT     5       // repetitions of each benchmark
+ 
+// Profiling (compile with -DENABLE_PROFILING to enable)
+#ifndef PROFILE_INTERVAL
+#define PROFILE_INTERVAL         1      // seconds between periodic stats lines
+#endif
+#define PROFILE_SLOT_AMT         64     // threads that can be profiled at the same time
+#define PROF_IS_MOVE_LEGAL       0
+#define PROF_IS_POS_AVAILABLE    1
+#define PROF_MOVE_PIECE          2
+#define PROF_CAPTURE_PIECE       3
+#define PROF_CHECK_GAME_STATUS   4
+#define PROF_DISPLAY_BOARD       5
+#define PROF_SEARCH_NODES        6
+#define PROF_CUTOFFS             7
+#define PROF_TT_HITS             8
+#define PROF_COUNTER_AMT         9
+ 
+#ifdef ENABLE_PROFILING
+#define PROFILE_START()          uint64_t profileStart = readCycles()
+#define PROFILE_STOP(counter)    addProfileSample(counter, readCycles() - profileStart)
+#define PROFILE_COUNT(counter)   addProfileSample(counter, 0)
+#define PROFILE_STATS(tag)       printProfileStats(tag)
+#else
+#define PROFILE_START()
+#define PROFILE_STOP(counter)
+#define PROFILE_COUNT(counter)
+#define PROFILE_STATS(tag)
+#endif
+ 
 // Position in the game board
 typedef struct pos {
     int row;
     int col;
 } Pos;
  
+// Rules that can be changed without recompiling (see parseRules())
+typedef struct rules {
+    int sParity;              // 0 if S squares have rows and columns of the same parity, 1 if not
+    int startRows;            // amount of rows of each player's starting positions
+    int pieceAmt;             // most pieces each player starts with
+} Rules;
+ 
 // Variable that contains (almost) all the game data
 typedef struct gameData {
     char gameBoard[ROW_INIT][COL_INIT]; // the actual game board
@@ -37,6 +206,546 @@ typedef struct gameData {
     int curPlayer;                      // the current player
 } GameData;
  
+// Game data packed into 64 bits (see packPos())
+typedef uint64_t PackedPos;
+ 
+// Fails to compile if the board is too large for a packed position
+typedef char PackedPosFits[PACKED_PLAYER_SHIFT < 64 ? 1 : -1];
+ 
+// columns are lettered from A to Z (see intColToCharCol())
+typedef char ColLettersFit[COL <= 26 ? 1 : -1];
+ 
+// encodeMove() stores a move in a byte
+typedef char MoveCodeFits[ROW * COL * 3 <= 256 ? 1 : -1];
+ 
+// every piece can cross the board, and game archives store the plies in a byte
+typedef char MaxPlyFits[2 * MAX_POS_AMT * (ROW - 1) <= MAX_PLY && MAX_PLY <= 255 ? 1 : -1];
+ 
+// A single move of a piece, as produced by generateMoves()
+typedef struct move {
+    Pos src;    // the position to be moved
+    Pos dest;   // the position where src is to be moved to
+    int type;   // 1 if the move just moves a piece, 2 if it captures
+} Move;
+ 
+// Weights of the features used by evaluatePosition()
+typedef struct evalWeights {
+    int material;     // per piece in play
+    int advancement;  // per row advanced towards the opponent's side
+    int onStart;      // per piece on the opponent's starting positions
+    int threatened;   // per piece on an S square that can be captured
+} EvalWeights;
+ 
+// A transposition table slot, read and written without locks (see probeTransTable())
+typedef struct ttEntry {
+    uint64_t check;                     // the key XOR-ed with data
+    uint64_t data;                      // the packed TTData
+} TTEntry;
+ 
+// What a transposition table stores for a position
+typedef struct ttData {
+    int score;                          // score of the position (see alphaBeta())
+    int depth;                          // how many plies the position was searched
+    int bound;                          // TT_EXACT, TT_LOWER or TT_UPPER
+    int moveCode;                       // the best move as encoded by encodeMove()
+} TTData;
+ 
+// Hash table of searched positions, which can be shared by many searches
+typedef struct transTable {
+    TTEntry *entries;                   // the slots of the table
+    uint64_t mask;                      // amount of slots - 1
+    unsigned char *mapping;             // the shared memory holding the table (NULL if private)
+    size_t mapSize;                     // size of mapping in bytes
+} TransTable;
+ 
+// Header of a transposition table in shared memory (see openSharedTransTable())
+typedef struct sharedTableHeader {
+    uint64_t magic;                     // SHARED_TABLE_MAGIC once the table is ready
+    uint32_t version;                   // SHARED_TABLE_VERSION
+    int32_t row;                        // ROW of the process that created the table
+    int32_t col;                        // COL of the process that created the table
+    int32_t maxPosAmt;                  // MAX_POS_AMT of the process that created the table
+    uint64_t entryAmt;                  // amount of slots
+} SharedTableHeader;
+ 
+// State of a search, kept across the iterations of searchBestMove()
+typedef struct searchInfo {
+    int useOrdering;                    // 1 to order moves, 0 to search them as generated
+    TransTable *pTable;                 // transposition table (NULL if none)
+    long long nodes;                    // amount of positions visited
+    long long ttHits;                   // amount of positions found in pTable
+    Move killers[MAX_PLY][2];           // quiet moves that caused a cutoff per ply
+    int history[3][ROW_INIT * COL_INIT][ROW_INIT * COL_INIT]; // cutoff scores per player, src, dest
+    Move bestMove;                      // best move found by the last completed iteration
+    int bestScore;                      // score of bestMove for the player to move
+} SearchInfo;
+ 
+// Bump allocator for scratch memory that is freed all at once (see arenaAlloc())
+typedef struct arena {
+    unsigned char *base;      // the reserved memory
+    size_t budget;            // size of the reserved memory in bytes
+    size_t used;              // bytes handed out since the last reset
+    size_t peak;              // most bytes handed out at the same time
+    long allocAmt;            // amount of allocations
+    long resetAmt;            // amount of resets
+    long failAmt;             // amount of allocations over the budget
+} Arena;
+ 
+// A game stored in a game archive (see readArchiveGame())
+typedef struct gameRecord {
+    int plyAmt;               // amount of plies played
+    int result;               // ALPHA_WIN, BETA_WIN, or GAME_ONGOING if neither won
+    unsigned char *moves;     // the moves as encoded by encodeMove()
+} GameRecord;
+ 
+// Games played by one self-play thread
+typedef struct selfPlayJob {
+    long startGame;           // number of the first game to be played
+    long endGame;             // number after the last game to be played
+    long nextGame;            // number of the first game not played yet
+    int depth;                // how many plies the players search ahead
+    uint64_t seed;            // seed shared by all games
+    unsigned char *data;      // the played games in archive format
+    long size;                // size of the finished games in data in bytes
+    long capacity;            // size of the mapping of data in bytes
+    int finished;             // 1 once every game of the job is played
+    Arena scratch;            // holds the search state of the game being played
+    Rules rules;              // the rules the games are played under
+} SelfPlayJob;
+ 
+// Header of a self-play checkpoint, followed by the games of each job
+typedef struct selfPlayCheckpoint {
+    char magic[4];            // SELFPLAY_CHECKPOINT_MAGIC
+    uint32_t version;         // CHECKPOINT_VERSION
+    int32_t jobAmt;           // amount of jobs the games are split across
+    int32_t depth;            // how many plies the players search ahead
+    int64_t gameAmt;          // amount of games played by every job
+    uint64_t seed;            // seed shared by all games
+    Rules rules;              // the rules the games are played under
+    int64_t sizes[MAX_THREAD_AMT]; // size of the finished games of each job
+} SelfPlayCheckpoint;
+ 
+// Entry of a proof-number solver's node table
+typedef struct pnEntry {
+    uint64_t key;             // hash of the position
+    uint32_t phi;             // see lookUpProofNumbers()
+    uint32_t delta;           // see lookUpProofNumbers()
+} PNEntry;
+ 
+// Depth-first proof-number solver (see solvePosition())
+typedef struct solver {
+    PNEntry *entries;         // the node table
+    uint64_t mask;            // amount of entries - 1
+    unsigned char *mapping;   // the mapping that holds the node table
+    size_t mapSize;           // size of mapping in bytes
+    long long nodes;          // amount of positions visited
+    long long maxNodes;       // most positions that may be visited (0 for no limit)
+    double deadline;          // getTime() at which to give up (0 for no limit)
+    int aborted;              // 1 if a limit was reached
+    uint64_t rootKey;         // hash of the position being solved
+    int attacker;             // the player whose win is being proven
+    char checkpointPath[CHECKPOINT_PATH_LEN]; // empty for no checkpoints
+    double nextCheckpoint;    // getTime() at which to write a checkpoint (0 for never)
+    long long nextCheckNodes; // nodes at which the clock is read next
+} Solver;
+ 
+// Header of a solver checkpoint (see saveSolverCheckpoint())
+typedef struct solverCheckpoint {
+    char magic[4];            // SOLVER_CHECKPOINT_MAGIC
+    uint32_t version;         // CHECKPOINT_VERSION
+    uint64_t rootKey;         // hash of the position being solved
+    uint64_t entryAmt;        // amount of entries of the node table
+    int64_t nodes;            // amount of positions visited so far
+    int32_t attacker;         // the player whose win is being proven
+    int32_t row;              // ROW of the solver
+    int32_t col;              // COL of the solver
+    Rules rules;              // the rules the position is solved under
+} SolverCheckpoint;
+ 
+// Verdict of a validated game
+typedef struct gameVerdict {
+    unsigned char verdict;    // VERDICT_OK or the first problem found
+    unsigned char ply;        // the ply of the problem
+} GameVerdict;
+ 
+// Carry-less range coder (see normalizeRange())
+typedef struct rangeCoder {
+    uint32_t low;             // low end of the range
+    uint32_t range;           // size of the range
+    uint32_t code;            // the bytes being decoded (decoder only)
+    unsigned char *data;      // the encoded bytes
+    long size;                // amount of bytes written or read so far
+    long capacity;            // amount of encoded bytes (decoder only)
+} RangeCoder;
+ 
+// Adaptive frequencies of moves by their index among the legal moves
+typedef struct moveModel {
+    uint16_t freqs[MAX_MOVE_AMT + 1][MAX_MOVE_AMT]; // by amount of legal moves
+    uint16_t totals[MAX_MOVE_AMT + 1];              // sum of each row of freqs
+} MoveModel;
+ 
+// Block of a compressed archive (see runCompressor())
+typedef struct archiveBlock {
+    long offset;              // offset of the compressed block
+    long size;                // size of the compressed block in bytes
+    long gameAmt;             // amount of games in the block
+    long outOffset;           // offset of the games in the decompressed archive
+    long outSize;             // size of the games in archive format in bytes
+} ArchiveBlock;
+ 
+// Compressed archive decompressed by every decompression thread
+typedef struct decompressJob {
+    unsigned char *data;      // the compressed archive
+    ArchiveBlock *blocks;     // the blocks of the compressed archive
+    long blockAmt;            // amount of blocks
+    long nextBlock;           // the next block to be claimed by a thread
+    unsigned char *out;       // the decompressed archive
+    int failed;               // 1 if a block is damaged
+    Rules rules;              // the rules the games were played under
+} DecompressJob;
+ 
+// Statistics of archived games (see addGameStats())
+typedef struct archiveStats {
+    long gameAmt;             // amount of games
+    long plyAmt;              // amount of plies of every game
+    long damagedAmt;          // amount of games that could not be replayed
+    long lengths[MAX_PLY + 1]; // amount of games by amount of plies (the last counts longer games too)
+    long endings[3][WIN_CONDITION_AMT]; // amount of games by result and win condition
+    long captures[ROW_INIT][COL_INIT];  // amount of captures by square
+} ArchiveStats;
+ 
+// Archive scanned by every statistics thread
+typedef struct statsJob {
+    unsigned char *data;      // the mapped archive, compressed or not
+    long size;                // size of data in bytes
+    int compressed;           // 1 if the archive is compressed
+    long offset;              // offset of the first game (or block) not claimed yet
+    int damaged;              // 1 if the archive is damaged or cut off
+    pthread_mutex_t lock;     // guards offset, damaged and total
+    ArchiveStats total;       // the statistics of every thread, added together
+    Rules rules;              // the rules the games were played under
+} StatsJob;
+ 
+// Variant of the rules compared by runSweep()
+typedef struct sweepVariant {
+    Rules rules;              // the rules of the variant
+    double cost;              // estimated cost (see estimateVariantCost())
+    long results[3];          // amount of self-play games by result
+    long plyAmt;              // amount of plies of every self-play game
+    int solved;               // the result for Alpha at the start (PN_*)
+    double elapsed;           // seconds the variant took
+} SweepVariant;
+ 
+// Variants swept by every sweep thread
+typedef struct sweepJob {
+    SweepVariant *variants;   // the variants, in the order they are printed
+    SweepVariant **order;     // the variants, from the most to the least costly
+    int variantAmt;           // amount of variants
+    int nextVariant;          // the next variant in order to be claimed by a thread
+    long gameAmt;             // amount of self-play games per variant
+    int depth;                // how many plies the players search ahead
+    uint64_t seed;            // seed shared by all games
+    size_t solverBudget;      // memory of the node table of each thread's solver
+    int failed;               // 1 if a thread could not reserve its search state
+} SweepJob;
+ 
+// Archive validated by every validation thread
+typedef struct validateJob {
+    unsigned char *data;      // the mapped archive
+    long size;                // size of data in bytes
+    long gameAmt;             // amount of complete games in the archive
+    long *chunkOffsets;       // offset of the first game of each chunk
+    long chunkAmt;            // amount of chunks
+    long nextChunk;           // the next chunk to be claimed by a thread
+    GameVerdict *verdicts;    // the verdict of each game
+    Rules rules;              // the rules the games are checked against
+} ValidateJob;
+ 
+// A position of an archived game, sorted by hash to find transpositions
+typedef struct annotatePos {
+    uint64_t hash;            // hash of packed
+    PackedPos packed;         // the position
+    long index;               // which position of the archive it is, in order
+} AnnotatePos;
+ 
+// Unique positions analyzed by every annotation thread
+typedef struct annotateJob {
+    PackedPos *unique;        // the unique positions
+    long uniqueAmt;           // amount of unique positions
+    long nextPos;             // the next position to be claimed by a thread
+    int depth;                // how many plies each position is searched
+    TransTable *pTable;       // transposition table shared by every thread
+    int *bestCodes;           // the best move of each position (-1 if none)
+    int *scores;              // the score of each position from Alpha's point of view
+    long long nodes;          // amount of positions visited by every search
+    Rules rules;              // the rules the positions are searched under
+    int failed;               // 1 if a thread could not reserve its search state
+} AnnotateJob;
+ 
+// Labeled positions stored as one contiguous array per feature
+typedef struct trainingSet {
+    long amt;                         // amount of positions
+    long capacity;                    // amount of positions that fit in the arrays
+    float *features[FEATURE_AMT];     // the features of each position
+    float *labels;                    // 1 if Alpha won, 0 if Beta won, 0.5 if neither
+} TrainingSet;
+ 
+// Slice of a training set processed by one tuning thread
+typedef struct tuneJob {
+    TrainingSet *pSet;                // the training set
+    long startPos;                    // index of the first position of the slice
+    long endPos;                      // index after the last position of the slice
+    double weights[FEATURE_AMT];      // current weights
+    double gradient[FEATURE_AMT];     // gradient of the loss over the slice
+    double loss;                      // sum of the loss over the slice
+} TuneJob;
+ 
+// Positions shared by the benchmarks (see runBenchmarks())
+typedef struct benchData {
+    uint64_t seed;                                  // seed of the positions and games
+    GameData positions[BENCH_POS_AMT];              // ongoing positions
+    Move moves[BENCH_POS_AMT][MAX_MOVE_AMT];        // the moves of each position
+    int moveAmts[BENCH_POS_AMT];                    // amount of moves of each position
+    SearchInfo search;                              // search state of the self-play games
+} BenchData;
+ 
+// Lines of input and the positions parsed from them (see getUserInput())
+typedef struct inputReader {
+    FILE *script;                     // move script read before stdin (NULL if none)
+    char line[INPUT_LINE_LEN];        // the last line read
+    Pos pending[INPUT_POS_AMT];       // positions parsed from the line
+    int pendingAmt;                   // amount of positions in pending
+    int pendingIndex;                 // index of the next position to be used
+} InputReader;
+ 
+// The squares that a move changed, as sent to spectators (see publishBoard())
+typedef struct boardDiff {
+    uint32_t ply;                              // the number of the move, from 1
+    uint8_t result;                            // the status of the game after the move (or BROADCAST_NO_MOVES)
+    uint8_t curPlayer;                         // the player to move next
+    uint8_t changeAmt;                         // amount of squares changed
+    uint8_t squares[BROADCAST_CHANGE_AMT];     // the changed squares (see posToIndex())
+    char marks[BROADCAST_CHANGE_AMT];          // the marks of the changed squares
+} BoardDiff;
+ 
+// The whole board, for spectators that join late or fall behind
+typedef struct boardSnapshot {
+    uint32_t ply;                              // the number of the last move
+    uint8_t result;                            // the status of the game (or BROADCAST_NO_MOVES)
+    uint8_t curPlayer;                         // the player to move next
+    char board[ROW_INIT][COL_INIT];            // the game board
+} BoardSnapshot;
+ 
+// A slot of the ring of diffs
+typedef struct broadcastSlot {
+    uint64_t seq;                              // ply of the diff (0 while it is being written)
+    BoardDiff diff;
+} BroadcastSlot;
+ 
+// Broadcast of a game in shared memory, written by the game and read by spectators
+typedef struct broadcastRing {
+    uint64_t magic;                            // BROADCAST_MAGIC once the broadcast is ready
+    uint32_t version;                          // BROADCAST_VERSION
+    int32_t row;                               // ROW of the game
+    int32_t col;                               // COL of the game
+    int32_t closed;                            // 1 once the game ended or was stopped
+    uint64_t head;                             // amount of diffs published
+    uint64_t snapshotSeq;                      // odd while the snapshot is being written
+    BoardSnapshot snapshot;                    // the board after the last diff
+    BroadcastSlot slots[BROADCAST_SLOT_AMT];   // the last diffs, by ply
+} BroadcastRing;
+ 
+// The game's side of a broadcast (see openBroadcast())
+typedef struct broadcaster {
+    BroadcastRing *pRing;                      // the shared memory of the broadcast
+    char *name;                                // the name of the broadcast
+    uint32_t ply;                              // amount of diffs published
+    char board[ROW_INIT][COL_INIT];            // the board as of the last diff
+} Broadcaster;
+ 
+// Options that change how a game is played
+typedef struct playOptions {
+    int aiPlayer;   // the player controlled by the computer (0 if none)
+    int aiDepth;    // how many plies the computer searches ahead
+    int aiUseSolver; // 1 to look for a forced win with proof-number search first
+    char *broadcastName; // name to broadcast the game to spectators under (NULL if none)
+} PlayOptions;
+ 
+// Rules that can be changed without recompiling (see parseRules()), per
+// thread so that variants can be played side by side
+__thread Rules gRules = {0, 2, MAX_POS_AMT};
+ 
+// Default evaluation weights
+EvalWeights gEvalWeights = {100, 4, 12, -30};
+ 
+// Input of the players
+InputReader gInput = {0};
+ 
+// Most memory a job may use for its tables (or the arenas of its threads)
+size_t gMemoryBudget = (size_t) DEFAULT_MEMORY_MB << 20;
+ 
+// Transposition table shared with other processes (NULL if none)
+TransTable *gSharedTable = NULL;
+ 
+// Seconds between checkpoints of long jobs (0 for no checkpoints)
+double gCheckpointInterval = DEFAULT_CHECKPOINT_SEC;
+ 
+#ifdef ENABLE_PROFILING
+// Profiling counters of one thread (or a few, see addProfileSample()), padded so threads do not share cache lines
+typedef struct profileSlot {
+    uint64_t calls[PROF_COUNTER_AMT];
+    uint64_t cycles[PROF_COUNTER_AMT];
+} __attribute__((aligned(64))) ProfileSlot;
+ 
+ProfileSlot gProfileSlots[PROFILE_SLOT_AMT];
+int gProfileSlotAmt = 0;
+double gProfileStartTime = 0;
+char *gProfileNames[PROF_COUNTER_AMT] = {
+    "isMoveLegal", "isPosAvailable", "movePiece", "capturePiece",
+    "checkGameStatus", "displayBoard", "searchNodes", "cutoffs", "ttHits"
+};
+#endif
+ 
+/**
+ * @brief Gets the current time of a monotonic clock.
+ *
+ * @return The current time in seconds.
+ */
+double getTime(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+ 
+#ifdef ENABLE_PROFILING
+/**
+ * @brief Reads a cycle counter for timing the hot paths of the game.
+ *
+ * @note
+ *    The time stamp counter is used on x86. Elsewhere, nanoseconds are used
+ *    instead of cycles.
+ *
+ * @return The current value of the counter.
+ */
+uint64_t readCycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return (uint64_t) (getTime() * 1e9);
+#endif
+}
+ 
+/**
+ * @brief Adds a call (and the cycles it took) to a profiling counter.
+ * @details
+ *    Each thread is given its own slot of counters the first time it adds a
+ *    call, so threads do not contend over the same cache lines. Slots are
+ *    reused once more than PROFILE_SLOT_AMT threads have been started, so two
+ *    threads can share a slot, and the reporter reads the slots while they
+ *    are updated. The counters are therefore added to atomically, which
+ *    costs little since a slot is rarely shared.
+ *
+ * @param counter   Which counter the call is added to (one of PROF_*).
+ * @param cycles    How many cycles the call took (0 if it is only counted).
+ */
+void addProfileSample(int counter, uint64_t cycles) {
+    static __thread int slot = -1;
+    if (slot == -1) {
+        slot = __atomic_fetch_add(&gProfileSlotAmt, 1, __ATOMIC_RELAXED) % PROFILE_SLOT_AMT;
+    }
+ 
+    __atomic_fetch_add(&gProfileSlots[slot].calls[counter], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&gProfileSlots[slot].cycles[counter], cycles, __ATOMIC_RELAXED);
+}
+ 
+/**
+ * @brief Sums the profiling counters of every thread.
+ *
+ * @param calls    Array where the amount of calls per counter is stored.
+ * @param cycles   Array where the amount of cycles per counter is stored.
+ */
+void sumProfileSlots(uint64_t calls[], uint64_t cycles[]) {
+    for (int i = 0; i < PROF_COUNTER_AMT; i++) {
+        calls[i] = 0;
+        cycles[i] = 0;
+        for (int j = 0; j < PROFILE_SLOT_AMT; j++) {
+            calls[i] += __atomic_load_n(&gProfileSlots[j].calls[i], __ATOMIC_RELAXED);
+            cycles[i] += __atomic_load_n(&gProfileSlots[j].cycles[i], __ATOMIC_RELAXED);
+        }
+    }
+}
+ 
+/**
+ * @brief Prints the profiling counters as a single line of JSON to stderr.
+ *
+ * @param tag   What the line is printed for (e.g. "periodic", "exit").
+ */
+void printProfileStats(char tag[]) {
+    uint64_t calls[PROF_COUNTER_AMT];
+    uint64_t cycles[PROF_COUNTER_AMT];
+    sumProfileSlots(calls, cycles);
+ 
+    fprintf(stderr, "{\"stats\":\"%s\",\"time\":%.3f", tag, getTime() - gProfileStartTime);
+    for (int i = 0; i < PROF_COUNTER_AMT; i++) {
+        fprintf(stderr, ",\"%s\":{\"calls\":%llu,\"cycles\":%llu}", gProfileNames[i],
+                (unsigned long long) calls[i], (unsigned long long) cycles[i]);
+    }
+    fprintf(stderr, "}\n");
+}
+ 
+/**
+ * @brief Prints a table of the profiling counters to stderr.
+ *
+ * @note Registered with atexit() by startProfiling().
+ */
+void printProfileReport(void) {
+    uint64_t calls[PROF_COUNTER_AMT];
+    uint64_t cycles[PROF_COUNTER_AMT];
+    sumProfileSlots(calls, cycles);
+ 
+    fprintf(stderr, "\nProfile (%.3f s, cycles include nested counters):\n", getTime() - gProfileStartTime);
+    fprintf(stderr, "%-16s %15s %18s %12s\n", "counter", "calls", "cycles", "cycles/call");
+    for (int i = 0; i < PROF_COUNTER_AMT; i++) {
+        fprintf(stderr, "%-16s %15llu %18llu %12.1f\n", gProfileNames[i],
+                (unsigned long long) calls[i], (unsigned long long) cycles[i],
+                calls[i] > 0 ? (double) cycles[i] / calls[i] : 0.0);
+    }
+    printProfileStats("exit");
+}
+ 
+/**
+ * @brief Prints the profiling counters every PROFILE_INTERVAL seconds.
+ *
+ * @param arg   Unused.
+ *
+ * @return Never returns.
+ */
+void *runProfileReporter(void *arg) {
+    struct timespec interval = {PROFILE_INTERVAL, 0};
+    (void) arg;
+ 
+    while (1) {
+        nanosleep(&interval, NULL);
+        printProfileStats("periodic");
+    }
+ 
+    return NULL;
+}
+ 
+/**
+ * @brief Starts the periodic stats line and the report printed on exit.
+ */
+void startProfiling(void) {
+    pthread_t reporter;
+    gProfileStartTime = getTime();
+    atexit(printProfileReport);
+ 
+    if (pthread_create(&reporter, NULL, runProfileReporter, NULL) == 0) {
+        pthread_detach(reporter);
+    }
+}
+#endif
+ 
 /**
  * @brief
  *    Converts a column from its integer representation to its character
@@ -51,12 +760,9 @@ typedef struct gameData {
 char intColToCharCol(int intCol) {
     char charCol = 0;
  
-    switch (intCol) {
-        case 1: charCol = 'A'; break;
-        case 2: charCol = 'B'; break;
-        case 3: charCol = 'C'; break;
-        case 4: charCol = 'D'; break;
-        case 5: charCol = 'E'; break;
+    // columns are lettered from A, for as many columns as the board has
+    if (intCol >= 1 && intCol <= COL) {
+        charCol = (char) ('A' + intCol - 1);
     }
  
     return charCol;
@@ -76,12 +782,8 @@ char intColToCharCol(int intCol) {
 int charColToIntCol(char charCol) {
     int intCol = 0;
  
-    switch (charCol) {
-        case 'A': intCol = 1; break;
-        case 'B': intCol = 2; break;
-        case 'C': intCol = 3; break;
-        case 'D': intCol = 4; break;
-        case 'E': intCol = 5; break;
+    if (charCol >= 'A' && charCol < 'A' + COL) {
+        intCol = charCol - 'A' + 1;
     }
  
     return intCol;
@@ -311,6 +1013,7 @@ void printDivider(char rowDivider[], char colDivider[], int cols) {
  * @param board   A 2D character array that represents the game board.
  */
 void displayBoard(char board[][COL_INIT]) {
+    PROFILE_START();
  
     printColHeader();
  
@@ -327,6 +1030,8 @@ void displayBoard(char board[][COL_INIT]) {
             printDivider("     ", "|", COL);
         }
     }
+ 
+    PROFILE_STOP(PROF_DISPLAY_BOARD);
 }
  
 /**
@@ -336,7 +1041,7 @@ void displayBoard(char board[][COL_INIT]) {
  *    value divided by 2 yield the same remainder. These positions are where
  *    the row and column values are either both even or both odd. These
  *    S squares are the only positions in the game board where captures can
- *    occur.
+ *    occur. If gRules.sParity is 1, S squares are the other squares instead.
  *
  * @note Change the rules of what an S square is in this function.
  *
@@ -349,7 +1054,7 @@ void displayBoard(char board[][COL_INIT]) {
  *    0   if the given position is not an S square.
  */
 int isSquareS(Pos givenPos) {
-    if (givenPos.row % 2 == givenPos.col % 2) {
+    if ((givenPos.row % 2 == givenPos.col % 2) != gRules.sParity) {
         return 1;
     } else {
         return 0;
@@ -359,8 +1064,9 @@ int isSquareS(Pos givenPos) {
 /**
  * @brief Checks if the given position is one of Alpha's starting positions.
  * @details
- *    Alpha's starting positions are S squares which row value is >= 6. These
- *    positions are located at the bottom side of the board.
+ *    Alpha's starting positions are S squares in the last gRules.startRows
+ *    rows (row value >= 6 by default). These positions are located at the
+ *    bottom side of the board.
  *
  * @note Change rules for Alpha's starting positions here.
  *
@@ -376,7 +1082,7 @@ int isSquareS(Pos givenPos) {
 int isPosAlphaStart(Pos givenPos) {
     int posIsAlphaStart = 0;
  
-    if (isSquareS(givenPos) == 1 && givenPos.row >= 6) {
+    if (isSquareS(givenPos) == 1 && givenPos.row > ROW - gRules.startRows) {
         posIsAlphaStart = 1;
     }
  
@@ -386,8 +1092,9 @@ int isPosAlphaStart(Pos givenPos) {
 /**
  * @brief Checks if the given position is one of Beta's starting positions.
  * @details
- *    Beta's starting positions are S squares which row value is <= 2. These
- *    positions are located at the top side of the board.
+ *    Beta's starting positions are S squares in the first gRules.startRows
+ *    rows (row value <= 2 by default). These positions are located at the
+ *    top side of the board.
  *
  * @note Change rules for Beta's starting positions here.
  *
@@ -403,7 +1110,7 @@ int isPosAlphaStart(Pos givenPos) {
 int isPosBetaStart(Pos givenPos) {
     int posIsBetaStart = 0;
  
-    if (isSquareS(givenPos) == 1 && givenPos.row <= 2) {
+    if (isSquareS(givenPos) == 1 && givenPos.row <= gRules.startRows) {
         posIsBetaStart = 1;
     }
  
@@ -439,29 +1146,6 @@ void displaySSquares(void) {
     displayBoard(tempBoard);
 }
  
-/**
- * @brief Displays the gameplay instructions.
- */
-void displayInstructions(void) {
-    char instructions[] =
-        "Instructions:\n\n"
-       
-        "- There are two players: Alpha and Beta.\n"
-        "- Alpha starts at the bottom of the board and moves first.\n"
-        "- Beta starts at the top of the board and moves second.\n"
-        "- Each player is given 5 pieces which can be moved a square forwards, either directly forward\n"
-        "  or diagonally.\n"
-        "- If a square is occupied by an opponent's piece, a player may capture it only if it is\n"
-        "  in an \"S square\", where the row and column are both even or both odd (shown below).\n"
-        "- If a piece is captured, it is removed from play and the capturing piece moves to that square.\n"
-        "- The game ends if a player's pieces are all captured or if all the player's remaining pieces manage\n"
-        "  to get to the starting positions of the opposing player.\n";
- 
-    printf("%s\n", instructions);
-    displaySSquares();
-    printf("\n\n");
-}
- 
 /**
  * @brief Initializes the game board by setting all positions to blank.
  *
@@ -483,22 +1167,42 @@ void initBoard(GameData *pGame) {
  *    it is stored in Alpha or Beta's starting and current positions array.
  *    The board is also visually updated accordingly.
  *
+ *    If there are more starting positions than gRules.pieceAmt, each player
+ *    fills them from their own side of the board: Beta takes the first ones
+ *    and Alpha takes the last ones. Unused starting positions are {0, 0}.
+ *
  * @param pGame   Contains game data.
  */
 void initPos(GameData *pGame) {
+    int pieceAmt = gRules.pieceAmt < MAX_POS_AMT ? gRules.pieceAmt : MAX_POS_AMT;
+    int alphaSkipAmt = -pieceAmt;
     pGame->alphaPosAmt = 0;
     pGame->betaPosAmt = 0;
  
+    for (int i = 0; i < MAX_POS_AMT; i++) {
+        Pos noPos = {0, 0};
+        pGame->alphaStartPos[i] = noPos;
+        pGame->betaStartPos[i] = noPos;
+    }
+ 
+    // Alpha skips the starting positions that are left over
+    for (int i = ROW - gRules.startRows + 1; i <= ROW; i++) {
+        for (int j = 1; j <= COL; j++) {
+            Pos square = {i, j};
+            alphaSkipAmt += isPosAlphaStart(square);
+        }
+    }
+ 
     for (int i = 1; i <= ROW; i++) {
         for (int j = 1; j <= COL; j++) {
             Pos square = {i, j};
             if (isPosBetaStart(square) == 1) {
-                if (pGame->betaPosAmt < MAX_POS_AMT) {
+                if (pGame->betaPosAmt < pieceAmt) {
                     pGame->betaStartPos[pGame->betaPosAmt] = square;
                     addPos(pGame, pGame->betaPos, &pGame->betaPosAmt, square, BETA_MARK);
                 }
-            } else if (isPosAlphaStart(square) == 1) {
-                if (pGame->alphaPosAmt < MAX_POS_AMT) {
+            } else if (isPosAlphaStart(square) == 1 && alphaSkipAmt-- <= 0) {
+                if (pGame->alphaPosAmt < pieceAmt) {
                     pGame->alphaStartPos[pGame->alphaPosAmt] = square;
                     addPos(pGame, pGame->alphaPos, &pGame->alphaPosAmt, square, ALPHA_MARK);
                 }
@@ -522,6 +1226,33 @@ void initGameData(GameData *pGame) {
     initPos(pGame);
 }
  
+/**
+ * @brief Displays the gameplay instructions.
+ */
+void displayInstructions(void) {
+    // the amount of pieces and the S squares depend on the rules (see gRules)
+    GameData game;
+    initGameData(&game);
+    char *sSquareRule = gRules.sParity ? "one of the row and column is even and the other is odd"
+                                       : "the row and column are both even or both odd";
+ 
+    printf("Instructions:\n\n"
+ 
+           "- There are two players: Alpha and Beta.\n"
+           "- Alpha starts at the bottom of the board and moves first.\n"
+           "- Beta starts at the top of the board and moves second.\n"
+           "- Each player is given %d pieces which can be moved a square forwards, either directly forward\n"
+           "  or diagonally.\n"
+           "- If a square is occupied by an opponent's piece, a player may capture it only if it is\n"
+           "  in an \"S square\", where %s (shown below).\n"
+           "- If a piece is captured, it is removed from play and the capturing piece moves to that square.\n"
+           "- The game ends if a player's pieces are all captured or if all the player's remaining pieces manage\n"
+           "  to get to the starting positions of the opposing player.\n\n",
+           game.alphaPosAmt, sSquareRule);
+    displaySSquares();
+    printf("\n\n");
+}
+ 
 /**
  * @brief
  *    Returns the integer representation of which player goes next in a
@@ -582,18 +1313,154 @@ char getPlayerMark(int curPlayer) {
     return playerMark;
 }
  
+/**
+ * @brief Reads the next line of input.
+ * @details
+ *    Lines are read from the move script first, if there is one. Once the
+ *    script ends, it is closed and lines are read from the standard input
+ *    stream instead. Lines from the script are echoed so that the output
+ *    shows what was entered. If a line does not fit in the buffer, the rest
+ *    of it is discarded.
+ *
+ * @return
+ *    1   if a line was read.
+ *    0   if there is no more input.
+ */
+int readInputLine(void) {
+    while (fgets(gInput.line, INPUT_LINE_LEN, gInput.script != NULL ? gInput.script : stdin) == NULL) {
+        if (gInput.script == NULL) {
+            return 0;
+        }
+ 
+        fclose(gInput.script);
+        gInput.script = NULL;
+    }
+ 
+    char *newline = strchr(gInput.line, '\n');
+    if (newline != NULL) {
+        *newline = '\0';
+    } else {
+        int c = 0;
+        FILE *stream = gInput.script != NULL ? gInput.script : stdin;
+        while ((c = fgetc(stream)) != '\n' && c != EOF) {
+            // discard the rest of the line
+        }
+    }
+ 
+    if (gInput.script != NULL) {
+        printf("%s\n", gInput.line);
+    }
+ 
+    return 1;
+}
+ 
+/**
+ * @brief Parses a position in column/row format (ex. C5).
+ *
+ * @param pText   Pointer to the text to be parsed, which is advanced past
+ *                the position if it is valid.
+ * @param pPos    Pointer to where the parsed position is stored.
+ *
+ * @return
+ *    1   if a valid position was parsed.
+ *    0   otherwise.
+ */
+int parsePos(char **pText, Pos *pPos) {
+    char *text = *pText;
+    char charCol = toupper((unsigned char) *text);
+    int row = 0;
+ 
+    // change rules for valid input here
+    if (charCol < 'A' || charCol >= 'A' + COL || !isdigit((unsigned char) text[1])) {
+        return 0;
+    }
+ 
+    text++;
+    while (isdigit((unsigned char) *text) && row <= ROW) {
+        row = row * 10 + (*text - '0');
+        text++;
+    }
+ 
+    if (row < 1 || row > ROW) {
+        return 0;
+    }
+ 
+    pPos->row = row;
+    pPos->col = charColToIntCol(charCol);
+    *pText = text;
+    return 1;
+}
+ 
+/**
+ * @brief Parses a line of input into positions.
+ * @details
+ *    The line is split into words, which are separated by spaces or commas.
+ *    Each word is either a position (ex. C5) or a whole move (ex. B6-B5),
+ *    which counts as two positions: the piece to be moved, and where it is
+ *    moved to. Every position is queued in gInput in the order it was
+ *    entered. If any word is invalid, nothing is queued.
+ *
+ * @return
+ *    1   if the line only contains valid words.
+ *    0   otherwise.
+ */
+int parseInputLine(void) {
+    char *text = gInput.line;
+    int posAmt = 0;
+ 
+    while (*text != '\0') {
+        if (isspace((unsigned char) *text) || *text == ',') {
+            text++;
+            continue;
+        }
+ 
+        if (posAmt + 2 > INPUT_POS_AMT || parsePos(&text, &gInput.pending[posAmt]) == 0) {
+            return 0;
+        }
+        posAmt++;
+ 
+        if (*text == '-') {
+            text++;
+            if (parsePos(&text, &gInput.pending[posAmt]) == 0) {
+                return 0;
+            }
+            posAmt++;
+        }
+ 
+        if (*text != '\0' && !isspace((unsigned char) *text) && *text != ',') {
+            return 0;
+        }
+    }
+ 
+    gInput.pendingAmt = posAmt;
+    gInput.pendingIndex = 0;
+    return 1;
+}
+ 
+/**
+ * @brief Discards the positions that were entered but not used yet.
+ *
+ * @note
+ *    Call this when an entered position is rejected so that the rest of the
+ *    line (ex. the destination of a whole move) is not used by mistake.
+ */
+void discardUserInput(void) {
+    gInput.pendingAmt = 0;
+    gInput.pendingIndex = 0;
+}
+ 
 /**
  * @brief Gets and validates user input.
  * @details
- *    The player is prompted for their input in a specific format. Afterwards,
- *    lowercase characters are converted to uppercase characters so lowercase
- *    characters are handled and accepted as well. The standard input stream
- *    is then cleared using fflush() to get rid of excess characters.
- *    
- *    The input is then validated, and if it is not valid according to the
- *    given rules, then the player is asked for their input again. Once the
- *    player enters a valid input, it is stored using pointers to external
- *    variables.
+ *    If positions from a previously entered line are still queued, the next
+ *    one is used without prompting the player. Otherwise, the player is
+ *    prompted for their input in a specific format, and a whole line is read
+ *    and parsed at once (see parseInputLine()). Lowercase characters are
+ *    accepted as well.
+ *
+ *    If the line is not valid according to the given rules, then the player
+ *    is asked for their input again. Once the player enters a valid input,
+ *    it is stored using pointers to external variables.
  *
  * @note
  *    The function asks the player for their input in a specific format
@@ -605,28 +1472,29 @@ char getPlayerMark(int curPlayer) {
  *              row value of a position.
  * @param col   Pointer to a variable that stores the player's input for the
  *              column value of a position.
+ *
+ * @return
+ *    1   if a position was entered.
+ *    0   if the input ended before a valid position was entered.
  */
-void getUserInput(int *row, int *col) {
-    char tempCol = 0;
-    int tempRow = 0;
-    int inputIsValid = 0;
- 
-    while (!inputIsValid) {
+int getUserInput(int *row, int *col) {
+    while (gInput.pendingIndex >= gInput.pendingAmt) {
         printf("Enter your input in column/row format. (ex. A1, C5, E7)\n");
+        printf("You may also enter a whole move. (ex. B6-B5)\n");
         printf("Input > ");
-        scanf("%c%d", &tempCol, &tempRow);
-        tempCol = toupper(tempCol);
-        fflush(stdin); // clear input stream
+        if (readInputLine() == 0) {
+            return 0;
+        }
  
-        // change rules for valid input here
-        if (tempCol >= 'A' && tempCol <= 'E' && tempRow >= 1 && tempRow <= ROW) {
-            inputIsValid = 1;
+        if (parseInputLine() == 0) {
+            discardUserInput();
         }
     }
  
-    tempCol = charColToIntCol(tempCol);
-    *row = tempRow;
-    *col = tempCol;
+    *row = gInput.pending[gInput.pendingIndex].row;
+    *col = gInput.pending[gInput.pendingIndex].col;
+    gInput.pendingIndex++;
+    return 1;
 }
  
 /**
@@ -643,15 +1511,20 @@ void getUserInput(int *row, int *col) {
  *    0   if the given position is occupied by a current player's piece.
  */
 int isPosAvailable(GameData *pGame, Pos givenPos) {
+    PROFILE_START();
     char curPlayerMark = getPlayerMark(pGame->curPlayer);
+    int posIsAvailable = 0;
  
     if (pGame->gameBoard[givenPos.row][givenPos.col] == EMPTY_MARK) {
-        return 1; // empty space
+        posIsAvailable = 1; // empty space
     } else if (pGame->gameBoard[givenPos.row][givenPos.col] != curPlayerMark) {
-        return 2; // space is occupied by an opponent's piece
+        posIsAvailable = 2; // space is occupied by an opponent's piece
     } else {
-        return 0; // space is occupied by a current player's piece
+        posIsAvailable = 0; // space is occupied by a current player's piece
     }
+ 
+    PROFILE_STOP(PROF_IS_POS_AVAILABLE);
+    return posIsAvailable;
 }
  
 /**
@@ -680,6 +1553,7 @@ int isPosAvailable(GameData *pGame, Pos givenPos) {
  *    0   if moving srcPos to destPos is not legal.
  */
 int isMoveLegal(int curPlayer, Pos srcPos, Pos destPos) {
+    PROFILE_START();
     int moveIsLegal = 0;
  
     if ((destPos.col == srcPos.col ||
@@ -690,6 +1564,7 @@ int isMoveLegal(int curPlayer, Pos srcPos, Pos destPos) {
              moveIsLegal = 1;
          }
    
+    PROFILE_STOP(PROF_IS_MOVE_LEGAL);
     return moveIsLegal;
 }
  
@@ -708,6 +1583,7 @@ int isMoveLegal(int curPlayer, Pos srcPos, Pos destPos) {
  *        has > 0 and <= MAX_POS_AMT positions.
  */
 void movePiece(GameData *pGame, Pos srcPos, Pos destPos) {
+    PROFILE_START();
     char mark = getSquareMark(pGame, srcPos);
  
     if (mark == ALPHA_MARK) {
@@ -717,6 +1593,8 @@ void movePiece(GameData *pGame, Pos srcPos, Pos destPos) {
         delPos(pGame, pGame->betaPos, &pGame->betaPosAmt, srcPos);
         addPos(pGame, pGame->betaPos, &pGame->betaPosAmt, destPos, mark);
     }
+ 
+    PROFILE_STOP(PROF_MOVE_PIECE);
 }
  
 /**
@@ -733,6 +1611,8 @@ void movePiece(GameData *pGame, Pos srcPos, Pos destPos) {
  * @pre   Alpha or Beta, whoever's piece is the captured, has > 0 positions.
  */
 void capturePiece(GameData *pGame, Pos srcPos, Pos destPos) {
+    PROFILE_START();
+ 
     // delete the captured piece first
     char mark = getSquareMark(pGame, srcPos);
     if (mark == ALPHA_MARK) {
@@ -744,6 +1624,8 @@ void capturePiece(GameData *pGame, Pos srcPos, Pos destPos) {
     // after deleting the captured piece, move capturing piece to the captured
     // piece's position
     movePiece(pGame, srcPos, destPos);
+ 
+    PROFILE_STOP(PROF_CAPTURE_PIECE);
 }
  
 /**
@@ -849,10 +1731,10 @@ int hasBetaWon(GameData *pGame) {
  *       (2) Either Alpha or Beta has all their remaining pieces placed on
  *           their opponent's starting positions.
  *
- *    First, it checks if Alpha has won or lost. If so, it immediately returns
- *    a value. If not, it checks if Beta has won or lost. If so, it returns
- *    a value. Otherwise, it means that the game is ongoing and returns the
- *    appropriate value.
+ *    First, it checks if Alpha has won or lost. If so, Beta is not checked
+ *    anymore. If not, it checks if Beta has won or lost. If neither has won
+ *    or lost, it means that the game is ongoing and returns the appropriate
+ *    value.
  *
  * @note This cannot detect if the game has drawed or softlocked.
  *
@@ -864,52 +1746,4099 @@ int hasBetaWon(GameData *pGame) {
  *    GAME_ONGOING   if the game is ongoing (there is no winner yet).
  */
 int checkGameStatus(GameData *pGame) {
+    PROFILE_START();
+    int over = GAME_ONGOING; // assume the game is ongoing
+ 
     int gameStatus = hasAlphaWon(pGame);
     switch (gameStatus) {
-        case  1: return ALPHA_WIN; break; // Alpha has won
-        case -1: return BETA_WIN; break; // Alpha has lost (Beta has won)
+        case  1: over = ALPHA_WIN; break; // Alpha has won
+        case -1: over = BETA_WIN; break; // Alpha has lost (Beta has won)
     }
  
-    gameStatus = hasBetaWon(pGame);
-    switch (gameStatus) {
-        case  1: return BETA_WIN; break; // Beta has won
-        case -1: return ALPHA_WIN; break; // Beta has lost (Alpha has won)
+    if (over == GAME_ONGOING) {
+        gameStatus = hasBetaWon(pGame);
+        switch (gameStatus) {
+            case  1: over = BETA_WIN; break; // Beta has won
+            case -1: over = ALPHA_WIN; break; // Beta has lost (Alpha has won)
+        }
     }
  
-    // game is ongoing
-    return GAME_ONGOING;
+    PROFILE_STOP(PROF_CHECK_GAME_STATUS);
+    return over;
 }
  
 /**
- * @brief Prompts the player to select a piece that they will move.
+ * @brief Packs game data into 64 bits.
+ * @details
+ *    The packed position is laid out as follows:
+ *       bits 0 to ROW * COL - 1   which squares are occupied, where square
+ *                                 (row, col) is bit (row - 1) * COL + col - 1.
+ *       next 2 * MAX_POS_AMT bits the owner of each occupied square in
+ *                                 increasing square order (1 for Beta).
+ *       next bit                  the current player (1 for Beta).
+ *    The starting positions are not stored since they only depend on the
+ *    rules, and the order of the pieces in the positions arrays is not
+ *    stored since it does not matter.
  *
  * @param pGame   Contains game data.
- * @param row     Pointer to where the row value of the chosen position will
- *                be stored.
- * @param col     Pointer to where the column value of the chosen position
- *                will be stored.
+ *
+ * @return The packed position.
  */
-void playerSelectPiece(GameData *pGame, int *row, int *col) {
-    int inputIsValid = 0;
-    int posIsAvailable = 0;
+PackedPos packPos(GameData *pGame) {
+    uint64_t occupied = 0;
+    uint64_t betaOccupied = 0;
  
-    while (!inputIsValid) {
-        printf("%s: Select a piece to move.\n",
-                pGame->curPlayer == 1 ? "Alpha" : "Beta");
-        Pos temp = {0};
-        getUserInput(&temp.row, &temp.col);
-        posIsAvailable = isPosAvailable(pGame, temp);
- 
-        // player must select a square that contains one of their pieces
-        if (posIsAvailable == 0) {
-            *row = temp.row;
-            *col = temp.col;
-            inputIsValid = 1;
-        } else {
-            printf("ERROR: You must select a piece of yours!\n");
-        }
-        printf("\n");
+    for (int i = 0; i < pGame->alphaPosAmt; i++) {
+        occupied |= 1ULL << ((pGame->alphaPos[i].row - 1) * COL + pGame->alphaPos[i].col - 1);
     }
+    for (int i = 0; i < pGame->betaPosAmt; i++) {
+        betaOccupied |= 1ULL << ((pGame->betaPos[i].row - 1) * COL + pGame->betaPos[i].col - 1);
+    }
+    occupied |= betaOccupied;
+ 
+    // the owner bit of a square is its rank among the occupied squares
+    PackedPos packed = occupied;
+    while (betaOccupied != 0) {
+        uint64_t square = betaOccupied & -betaOccupied;
+        packed |= 1ULL << (PACKED_OWNER_SHIFT + __builtin_popcountll(occupied & (square - 1)));
+        betaOccupied &= betaOccupied - 1;
+    }
+ 
+    if (pGame->curPlayer == 2) {
+        packed |= 1ULL << PACKED_PLAYER_SHIFT;
+    }
+ 
+    return packed;
+}
+ 
+/**
+ * @brief Unpacks a position packed by packPos() into game data.
+ *
+ * @param packed   The packed position.
+ * @param pGame    Contains game data, whose board, pieces and current player
+ *                 are overwritten.
+ *
+ * @pre   pGame was initialized by initGameData() (its starting positions are
+ *        kept as they are).
+ */
+void unpackPos(PackedPos packed, GameData *pGame) {
+    initBoard(pGame);
+    pGame->alphaPosAmt = 0;
+    pGame->betaPosAmt = 0;
+    pGame->curPlayer = (packed >> PACKED_PLAYER_SHIFT) & 1 ? 2 : 1;
+ 
+    uint64_t occupied = packed & PACKED_BOARD_MASK;
+    for (int rank = 0; occupied != 0; rank++) {
+        int square = __builtin_ctzll(occupied);
+        Pos square2D = {square / COL + 1, square % COL + 1};
+ 
+        if ((packed >> (PACKED_OWNER_SHIFT + rank)) & 1) {
+            addPos(pGame, pGame->betaPos, &pGame->betaPosAmt, square2D, BETA_MARK);
+        } else {
+            addPos(pGame, pGame->alphaPos, &pGame->alphaPosAmt, square2D, ALPHA_MARK);
+        }
+        occupied &= occupied - 1;
+    }
+}
+ 
+/**
+ * @brief Compares two packed positions, such as for qsort().
+ *
+ * @return
+ *    -1   if packed1 is ordered before packed2.
+ *    1    if packed1 is ordered after packed2.
+ *    0    if both are the same position.
+ */
+int comparePackedPos(PackedPos packed1, PackedPos packed2) {
+    return packed1 < packed2 ? -1 : packed1 > packed2 ? 1 : 0;
+}
+ 
+/**
+ * @brief Hashes a packed position so that similar positions spread out.
+ *
+ * @param packed   The packed position.
+ *
+ * @return The 64-bit hash of the position.
+ */
+uint64_t hashPackedPos(PackedPos packed) {
+    packed ^= packed >> 33;
+    packed *= 0xFF51AFD7ED558CCDULL;
+    packed ^= packed >> 33;
+    packed *= 0xC4CEB9FE1A85EC53ULL;
+    packed ^= packed >> 33;
+    return packed;
+}
+ 
+/**
+ * @brief Gets the index of the given position in a flattened game board.
+ *
+ * @param givenPos   The position to be converted.
+ *
+ * @pre   givenPos is a valid position in the game board.
+ *
+ * @return The index of givenPos, which is < ROW_INIT * COL_INIT.
+ */
+int posToIndex(Pos givenPos) {
+    return givenPos.row * COL_INIT + givenPos.col;
+}
+ 
+/**
+ * @brief Generates all the moves that the current player can make.
+ * @details
+ *    For each of the current player's pieces, the three squares forward
+ *    (directly forward and both diagonals) are checked using the same rules
+ *    that playerMovePiece() enforces: the move must be legal, the destination
+ *    must not be occupied by one of the current player's pieces, and an
+ *    opponent's piece can only be captured in an S square.
+ *
+ * @param pGame   Contains game data.
+ * @param moves   Array where the generated moves are stored.
+ *
+ * @pre   moves can hold at least MAX_MOVE_AMT elements.
+ *
+ * @return The amount of moves stored in moves.
+ */
+int generateMoves(GameData *pGame, Move moves[]) {
+    Pos *positions = pGame->curPlayer == 1 ? pGame->alphaPos : pGame->betaPos;
+    int posAmt = pGame->curPlayer == 1 ? pGame->alphaPosAmt : pGame->betaPosAmt;
+    int forward = pGame->curPlayer == 1 ? -1 : 1;
+    int moveAmt = 0;
+ 
+    for (int i = 0; i < posAmt; i++) {
+        for (int j = -1; j <= 1; j++) {
+            Pos destPos = {positions[i].row + forward, positions[i].col + j};
+            if (destPos.row < 1 || destPos.row > ROW ||
+                destPos.col < 1 || destPos.col > COL) {
+                continue;
+            }
+ 
+            if (isMoveLegal(pGame->curPlayer, positions[i], destPos) == 0) {
+                continue;
+            }
+ 
+            int posIsAvailable = isPosAvailable(pGame, destPos);
+            if (posIsAvailable == 0 ||
+                (posIsAvailable == 2 && isSquareS(destPos) == 0)) {
+                continue;
+            }
+ 
+            moves[moveAmt].src = positions[i];
+            moves[moveAmt].dest = destPos;
+            moves[moveAmt].type = posIsAvailable;
+            moveAmt++;
+        }
+    }
+ 
+    return moveAmt;
+}
+ 
+/**
+ * @brief Executes the given move, then passes the turn to the other player.
+ *
+ * @param pGame   Contains game data.
+ * @param move    The move to be executed.
+ *
+ * @pre   move was generated by generateMoves() for the current game data.
+ */
+void applyMove(GameData *pGame, Move move) {
+    if (move.type == 1) {
+        movePiece(pGame, move.src, move.dest);
+    } else {
+        capturePiece(pGame, move.src, move.dest);
+    }
+ 
+    pGame->curPlayer = switchPlayer(pGame->curPlayer);
+}
+ 
+/**
+ * @brief Encodes a move into a single byte for game archives.
+ * @details
+ *    The source position is flattened into a square number from 0 to
+ *    ROW * COL - 1, which is multiplied by 3 and added to the direction
+ *    of the move (0 for left, 1 for directly forward, 2 for right). The row
+ *    of the destination is implied by whose turn it is.
+ *
+ * @param move   The move to be encoded.
+ *
+ * @return The byte that represents the move.
+ */
+unsigned char encodeMove(Move move) {
+    int square = (move.src.row - 1) * COL + (move.src.col - 1);
+    return (unsigned char) (square * 3 + (move.dest.col - move.src.col + 1));
+}
+ 
+/**
+ * @brief Decodes a move encoded by encodeMove().
+ * @details
+ *    The move type is taken from the board: a move onto an opponent's piece
+ *    is a capture. Nothing is validated, so the decoded move should be
+ *    checked before it is executed if the archive is not trusted.
+ *
+ * @param pGame   Contains game data (the position the move is played in).
+ * @param code    The byte that represents the move.
+ * @param pMove   Pointer to where the decoded move is stored.
+ *
+ * @return
+ *    1   if the code refers to positions inside the game board.
+ *    0   otherwise.
+ */
+int decodeMove(GameData *pGame, unsigned char code, Move *pMove) {
+    int square = code / 3;
+    if (square >= ROW * COL) {
+        return 0;
+    }
+ 
+    pMove->src.row = square / COL + 1;
+    pMove->src.col = square % COL + 1;
+    pMove->dest.row = pMove->src.row + (pGame->curPlayer == 1 ? -1 : 1);
+    pMove->dest.col = pMove->src.col + code % 3 - 1;
+    if (pMove->dest.row < 1 || pMove->dest.row > ROW ||
+        pMove->dest.col < 1 || pMove->dest.col > COL) {
+        return 0;
+    }
+ 
+    pMove->type = getSquareMark(pGame, pMove->dest) == EMPTY_MARK ? 1 : 2;
+    return 1;
+}
+ 
+/**
+ * @brief Writes a move in column/row format (ex. B6-B5).
+ *
+ * @param move     The move to be written.
+ * @param buffer   Where the move is written, which can hold at least 8
+ *                 characters.
+ */
+void formatMove(Move move, char buffer[]) {
+    sprintf(buffer, "%c%d-%c%d", intColToCharCol(move.src.col), move.src.row,
+            intColToCharCol(move.dest.col), move.dest.row);
+}
+ 
+/**
+ * @brief Checks if the given piece can be captured by the opponent.
+ * @details
+ *    A piece can only be captured if it is on an S square and one of the
+ *    opponent's pieces is one square "behind" it (from the piece owner's
+ *    point of view), either directly or diagonally.
+ *
+ * @param pGame         Contains game data.
+ * @param givenPos      The position of the piece to be checked.
+ * @param enemyMark     The mark of the opponent's pieces.
+ * @param enemyRowDir   The direction the opponent's pieces move in (-1 or 1).
+ *
+ * @return
+ *    1   if the given piece can be captured.
+ *    0   if the given piece cannot be captured.
+ */
+int isPieceThreatened(GameData *pGame, Pos givenPos, char enemyMark, int enemyRowDir) {
+    if (isSquareS(givenPos) == 0) {
+        return 0;
+    }
+ 
+    int row = givenPos.row - enemyRowDir;
+    if (row < 1 || row > ROW) {
+        return 0;
+    }
+ 
+    for (int col = givenPos.col - 1; col <= givenPos.col + 1; col++) {
+        if (col >= 1 && col <= COL && pGame->gameBoard[row][col] == enemyMark) {
+            return 1;
+        }
+    }
+ 
+    return 0;
+}
+ 
+/**
+ * @brief Counts the positions in an array that are also in another array.
+ *
+ * @param positions      Array of positions to be counted.
+ * @param posAmt         The amount of elements in positions.
+ * @param targets        Array of positions to be checked against.
+ * @param targetAmt      The amount of elements in targets.
+ *
+ * @return The amount of elements of positions that are in targets.
+ */
+int countPosIn(Pos positions[], int posAmt, Pos targets[], int targetAmt) {
+    int count = 0;
+ 
+    for (int i = 0; i < posAmt; i++) {
+        if (searchPos(targets, targetAmt, positions[i]) != -1) {
+            count++;
+        }
+    }
+ 
+    return count;
+}
+ 
+/**
+ * @brief Computes the evaluation features of the given game data.
+ * @details
+ *    Every feature is computed from Alpha's point of view, i.e. as Alpha's
+ *    value minus Beta's value:
+ *       [0] material      pieces in play (alphaPosAmt and betaPosAmt).
+ *       [1] advancement   rows advanced towards the opponent's starting
+ *                         positions.
+ *       [2] onStart       pieces already on the opponent's starting positions.
+ *       [3] threatened    pieces on S squares that the opponent can capture.
+ *
+ * @param pGame      Contains game data.
+ * @param features   Array where the FEATURE_AMT features are stored.
+ */
+void computeFeatures(GameData *pGame, int features[]) {
+    int alphaAdvance = 0;
+    int betaAdvance = 0;
+    int alphaThreatened = 0;
+    int betaThreatened = 0;
+ 
+    for (int i = 0; i < pGame->alphaPosAmt; i++) {
+        alphaAdvance += ROW - pGame->alphaPos[i].row;
+        alphaThreatened += isPieceThreatened(pGame, pGame->alphaPos[i], BETA_MARK, 1);
+    }
+ 
+    for (int i = 0; i < pGame->betaPosAmt; i++) {
+        betaAdvance += pGame->betaPos[i].row - 1;
+        betaThreatened += isPieceThreatened(pGame, pGame->betaPos[i], ALPHA_MARK, -1);
+    }
+ 
+    features[0] = pGame->alphaPosAmt - pGame->betaPosAmt;
+    features[1] = alphaAdvance - betaAdvance;
+    features[2] = countPosIn(pGame->alphaPos, pGame->alphaPosAmt, pGame->betaStartPos, MAX_POS_AMT) -
+                  countPosIn(pGame->betaPos, pGame->betaPosAmt, pGame->alphaStartPos, MAX_POS_AMT);
+    features[3] = alphaThreatened - betaThreatened;
+}
+ 
+/**
+ * @brief Statically evaluates the given game data.
+ *
+ * @note Change the weights of each feature in gEvalWeights.
+ *
+ * @param pGame   Contains game data.
+ *
+ * @return
+ *    The score of the position from the current player's point of view
+ *    (positive if the current player is better off).
+ */
+int evaluatePosition(GameData *pGame) {
+    int features[FEATURE_AMT] = {0};
+    computeFeatures(pGame, features);
+ 
+    int score = gEvalWeights.material * features[0] +
+                gEvalWeights.advancement * features[1] +
+                gEvalWeights.onStart * features[2] +
+                gEvalWeights.threatened * features[3];
+ 
+    return pGame->curPlayer == 1 ? score : -score;
+}
+ 
+/**
+ * @brief Checks if two moves are the same.
+ *
+ * @return
+ *    1   if move1 and move2 move the same piece to the same position.
+ *    0   otherwise.
+ */
+int isSameMove(Move move1, Move move2) {
+    return move1.src.row == move2.src.row && move1.src.col == move2.src.col &&
+           move1.dest.row == move2.dest.row && move1.dest.col == move2.dest.col;
+}
+ 
+/**
+ * @brief Sorts moves so that the ones most likely to cause a cutoff go first.
+ * @details
+ *    At the root, the best move of the previous iteration goes first. The
+ *    best move stored in the transposition table goes next, then captures,
+ *    then the killer moves of the current ply, and then the remaining moves
+ *    ordered by their history score. A simple
+ *    selection sort is used since there are at most MAX_MOVE_AMT moves.
+ *
+ * @param pInfo     Contains the search state.
+ * @param curPlayer The integer representation of the current player.
+ * @param ply       How many plies deep the moves are from the root.
+ * @param hashMoveCode  The encoded best move from the transposition table
+ *                      (-1 if there is none).
+ * @param moves     The moves to be sorted.
+ * @param moveAmt   The amount of elements in moves.
+ */
+void orderMoves(SearchInfo *pInfo, int curPlayer, int ply, int hashMoveCode, Move moves[], int moveAmt) {
+    int scores[MAX_MOVE_AMT] = {0};
+ 
+    for (int i = 0; i < moveAmt; i++) {
+        if (ply == 0 && isSameMove(moves[i], pInfo->bestMove)) {
+            scores[i] = 5000000; // best move of the previous iteration
+        } else if (encodeMove(moves[i]) == hashMoveCode) {
+            scores[i] = 4000000;
+        } else if (moves[i].type == 2) {
+            scores[i] = 3000000;
+        } else if (isSameMove(moves[i], pInfo->killers[ply][0])) {
+            scores[i] = 2000000;
+        } else if (isSameMove(moves[i], pInfo->killers[ply][1])) {
+            scores[i] = 1000000;
+        } else {
+            scores[i] = pInfo->history[curPlayer][posToIndex(moves[i].src)][posToIndex(moves[i].dest)];
+        }
+    }
+ 
+    for (int i = 0; i < moveAmt - 1; i++) {
+        int best = i;
+        for (int j = i + 1; j < moveAmt; j++) {
+            if (scores[j] > scores[best]) {
+                best = j;
+            }
+        }
+ 
+        Move tempMove = moves[i];
+        moves[i] = moves[best];
+        moves[best] = tempMove;
+        int tempScore = scores[i];
+        scores[i] = scores[best];
+        scores[best] = tempScore;
+    }
+}
+ 
+/**
+ * @brief Remembers a quiet move that caused a cutoff.
+ * @details
+ *    The move becomes the first killer move of the ply (the previous first
+ *    killer becomes the second), and its history score is increased by the
+ *    square of the remaining depth so that cutoffs near the root count more.
+ *
+ * @param pInfo       Contains the search state.
+ * @param curPlayer   The integer representation of the current player.
+ * @param ply         How many plies deep the move is from the root.
+ * @param depth       The remaining depth of the search at the move.
+ * @param move        The move that caused the cutoff.
+ */
+void storeCutoff(SearchInfo *pInfo, int curPlayer, int ply, int depth, Move move) {
+    if (move.type == 2) {
+        return; // captures are already ordered first
+    }
+ 
+    if (!isSameMove(move, pInfo->killers[ply][0])) {
+        pInfo->killers[ply][1] = pInfo->killers[ply][0];
+        pInfo->killers[ply][0] = move;
+    }
+ 
+    pInfo->history[curPlayer][posToIndex(move.src)][posToIndex(move.dest)] += depth * depth;
+}
+ 
+/**
+ * @brief Reserves a transposition table.
+ * @details
+ *    The table holds the largest power of two of entries that fits in the
+ *    budget, so that a hash can be turned into an index with a mask.
+ *
+ * @param pTable   The table to be initialized.
+ * @param budget   The most bytes the table can take up.
+ *
+ * @return
+ *    1   if the memory was reserved.
+ *    0   otherwise.
+ */
+int initTransTable(TransTable *pTable, size_t budget) {
+    size_t entryAmt = 1;
+    while (entryAmt * 2 * sizeof(TTEntry) <= budget) {
+        entryAmt *= 2;
+    }
+ 
+    pTable->entries = calloc(entryAmt, sizeof(TTEntry));
+    pTable->mask = pTable->entries != NULL ? entryAmt - 1 : 0;
+    pTable->mapping = NULL;
+    pTable->mapSize = 0;
+    return pTable->entries != NULL;
+}
+ 
+/**
+ * @brief Releases the memory of a transposition table.
+ *
+ * @param pTable   The table.
+ */
+void freeTransTable(TransTable *pTable) {
+    if (pTable->mapping != NULL) {
+        munmap(pTable->mapping, pTable->mapSize);
+    } else {
+        free(pTable->entries);
+    }
+    pTable->mapping = NULL;
+    pTable->mapSize = 0;
+    pTable->entries = NULL;
+    pTable->mask = 0;
+}
+ 
+/**
+ * @brief Gets the hash of this thread's rules, which is mixed into the keys
+ *        of transposition table entries.
+ * @details
+ *    Searches with different rules (see gRules) can share a table, but a
+ *    position is not worth the same under different rules, so the same
+ *    position gets a different key under each variant of the rules.
+ *
+ * @return The hash of the rules.
+ */
+uint64_t getRulesKey(void) {
+    PackedPos rules = (uint64_t) gRules.sParity << 63 | (uint64_t) (uint32_t) gRules.startRows << 32 |
+                      (uint32_t) gRules.pieceAmt;
+    return hashPackedPos(rules);
+}
+ 
+/**
+ * @brief Opens a transposition table in named shared memory, creating it
+ *        if no other process has yet.
+ * @details
+ *    The first process creates the segment with the size that fits the
+ *    budget, readable and writable only by its user, and marks its header
+ *    ready once it is set up. Other processes wait for the segment to be
+ *    sized and for the header, then map the table with the size it was created
+ *    with. Entries are probed and stored without locks as in a private
+ *    table, since the checks of probeTransTable() hold across processes as
+ *    well. The segment outlives the processes, so that later games reuse
+ *    what earlier ones searched, until it is removed (see --remove-table).
+ *
+ *    With huge pages, the kernel is asked to back the table with
+ *    transparent huge pages, which depends on its shared memory settings
+ *    (/sys/kernel/mm/transparent_hugepage/shmem_enabled).
+ *
+ * @param pTable          The table to be initialized.
+ * @param name            The name of the segment (ex. /scga-table).
+ * @param budget          The most bytes the entries can take up.
+ * @param useHugePages    1 to ask for huge pages.
+ *
+ * @return
+ *    1   if the table was opened.
+ *    0   otherwise.
+ */
+int openSharedTransTable(TransTable *pTable, char name[], size_t budget, int useHugePages) {
+    size_t entryAmt = 1;
+    while (entryAmt * 2 * sizeof(TTEntry) <= budget) {
+        entryAmt *= 2;
+    }
+ 
+    struct stat fileStat;
+    size_t size = SHARED_TABLE_HEADER_SIZE + entryAmt * sizeof(TTEntry);
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    int created = fd != -1;
+    if (!created && errno == EEXIST) {
+        fd = shm_open(name, O_RDWR, 0);
+    }
+ 
+    int isReady = fd != -1 && (created ? ftruncate(fd, size) == 0 : fstat(fd, &fileStat) == 0);
+    // the process that created the segment may not have sized it yet
+    for (int i = 0; !created && isReady && fileStat.st_size == 0 && i < SHARED_TABLE_WAIT_AMT; i++) {
+        usleep(1000);
+        isReady = fstat(fd, &fileStat) == 0;
+    }
+    size = created || !isReady ? size : (size_t) fileStat.st_size;
+    unsigned char *mapping = MAP_FAILED;
+    if (isReady && size > SHARED_TABLE_HEADER_SIZE) {
+        mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (fd != -1) {
+        close(fd);
+    }
+    if (mapping == MAP_FAILED) {
+        if (created) {
+            shm_unlink(name);
+        }
+        return 0;
+    }
+ 
+    if (useHugePages && madvise(mapping, size, MADV_HUGEPAGE) != 0) {
+        printf("Huge pages are not available for %s.\n", name);
+    }
+ 
+    // the header is only marked ready once the rest of it is written
+    SharedTableHeader *pHeader = (SharedTableHeader *) mapping;
+    if (created) {
+        SharedTableHeader header = {0, SHARED_TABLE_VERSION, ROW, COL, MAX_POS_AMT, entryAmt};
+        *pHeader = header;
+        __atomic_store_n(&pHeader->magic, SHARED_TABLE_MAGIC, __ATOMIC_RELEASE);
+    }
+    for (int i = 0; i < SHARED_TABLE_WAIT_AMT && __atomic_load_n(&pHeader->magic, __ATOMIC_ACQUIRE) == 0; i++) {
+        usleep(1000);
+    }
+ 
+    entryAmt = pHeader->entryAmt;
+    if (__atomic_load_n(&pHeader->magic, __ATOMIC_ACQUIRE) != SHARED_TABLE_MAGIC ||
+        pHeader->version != SHARED_TABLE_VERSION || pHeader->row != ROW || pHeader->col != COL ||
+        pHeader->maxPosAmt != MAX_POS_AMT || entryAmt == 0 || (entryAmt & (entryAmt - 1)) != 0 ||
+        size != SHARED_TABLE_HEADER_SIZE + entryAmt * sizeof(TTEntry)) {
+        printf("ERROR: %s is not a table of this version of the game!\n", name);
+        munmap(mapping, size);
+        return 0;
+    }
+ 
+    pTable->entries = (TTEntry *) (mapping + SHARED_TABLE_HEADER_SIZE);
+    pTable->mask = entryAmt - 1;
+    pTable->mapping = mapping;
+    pTable->mapSize = size;
+    return 1;
+}
+ 
+/**
+ * @brief Removes a shared transposition table, once every process using it
+ *        has closed it.
+ *
+ * @param name   The name of the segment.
+ *
+ * @return
+ *    0   if the table was removed.
+ *    1   otherwise.
+ */
+int removeSharedTransTable(char name[]) {
+    int removed = shm_unlink(name) == 0;
+    if (!removed) {
+        printf("ERROR: Could not remove %s!\n", name);
+    }
+    return !removed;
+}
+ 
+/**
+ * @brief Looks up a position in a transposition table.
+ * @details
+ *    Entries are read and written without locks by every thread. An entry
+ *    stores its key XOR-ed with its data as a checksum, so an entry that was
+ *    torn by two threads writing at the same time does not match any key
+ *    and is ignored. The key also depends on the rules the position was
+ *    searched under (see getRulesKey()).
+ *
+ * @param pTable   The table.
+ * @param key      The hash of the position (see hashPackedPos()).
+ * @param pEntry   Pointer to where the entry is stored if it is found.
+ *
+ * @return
+ *    1   if the position was found.
+ *    0   otherwise.
+ */
+int probeTransTable(TransTable *pTable, uint64_t key, TTData *pEntry) {
+    key ^= getRulesKey();
+    TTEntry *pSlot = &pTable->entries[key & pTable->mask];
+    uint64_t data = __atomic_load_n(&pSlot->data, __ATOMIC_RELAXED);
+    uint64_t check = __atomic_load_n(&pSlot->check, __ATOMIC_RELAXED);
+    if ((check ^ data) != key || data == 0) {
+        return 0;
+    }
+ 
+    pEntry->score = (int) (int32_t) (uint32_t) data;
+    pEntry->depth = (int) ((data >> 32) & 0xFF);
+    pEntry->bound = (int) ((data >> 40) & 0xFF);
+    pEntry->moveCode = (int) ((data >> 48) & 0xFF);
+    return 1;
+}
+ 
+/**
+ * @brief Stores a position in a transposition table.
+ *
+ * @param pTable   The table.
+ * @param key      The hash of the position (see hashPackedPos()).
+ * @param entry    What is stored for the position.
+ */
+void storeTransTable(TransTable *pTable, uint64_t key, TTData entry) {
+    key ^= getRulesKey();
+    TTEntry *pSlot = &pTable->entries[key & pTable->mask];
+    uint64_t data = (uint64_t) (uint32_t) entry.score |
+                    (uint64_t) (entry.depth & 0xFF) << 32 |
+                    (uint64_t) (entry.bound & 0xFF) << 40 |
+                    (uint64_t) (entry.moveCode & 0xFF) << 48;
+ 
+    __atomic_store_n(&pSlot->data, data, __ATOMIC_RELAXED);
+    __atomic_store_n(&pSlot->check, key ^ data, __ATOMIC_RELAXED);
+}
+ 
+/**
+ * @brief Searches the game tree using negamax with alpha-beta pruning.
+ * @details
+ *    If the search has a transposition table, positions that were already
+ *    searched deep enough are not searched again (except at the root, where
+ *    the best move is needed), and the best move stored for a position is
+ *    searched first.
+ *
+ * @note
+ *    A player with no moves left cannot do anything, and since the game
+ *    cannot detect this (see checkGameStatus()), it is scored as a draw.
+ *
+ * @param pGame   Contains game data.
+ * @param pInfo   Contains the search state.
+ * @param depth   How many more plies to search.
+ * @param ply     How many plies deep the search is from the root.
+ * @param alpha   Lower bound of the score.
+ * @param beta    Upper bound of the score.
+ *
+ * @return The score of the position from the current player's point of view.
+ */
+int alphaBeta(GameData *pGame, SearchInfo *pInfo, int depth, int ply, int alpha, int beta) {
+    pInfo->nodes++;
+    PROFILE_COUNT(PROF_SEARCH_NODES);
+ 
+    // the previous player's move may have ended the game
+    int over = checkGameStatus(pGame);
+    if (over != GAME_ONGOING) {
+        return over == pGame->curPlayer ? WIN_SCORE - ply : -(WIN_SCORE - ply);
+    }
+ 
+    if (depth == 0 || ply >= MAX_PLY - 1) {
+        return evaluatePosition(pGame);
+    }
+ 
+    uint64_t key = 0;
+    TTData entry = {0, 0, 0, -1};
+    if (pInfo->pTable != NULL) {
+        key = hashPackedPos(packPos(pGame));
+        if (probeTransTable(pInfo->pTable, key, &entry)) {
+            pInfo->ttHits++;
+            PROFILE_COUNT(PROF_TT_HITS);
+ 
+            // win and loss scores are stored relative to the position
+            int score = entry.score > WIN_SCORE - MAX_PLY ? entry.score - ply :
+                        entry.score < -(WIN_SCORE - MAX_PLY) ? entry.score + ply : entry.score;
+            if (ply > 0 && entry.depth >= depth &&
+                (entry.bound == TT_EXACT ||
+                 (entry.bound == TT_LOWER && score >= beta) ||
+                 (entry.bound == TT_UPPER && score <= alpha))) {
+                return score;
+            }
+        }
+    }
+ 
+    Move moves[MAX_MOVE_AMT];
+    int moveAmt = generateMoves(pGame, moves);
+    if (moveAmt == 0) {
+        return 0;
+    }
+ 
+    if (pInfo->useOrdering) {
+        orderMoves(pInfo, pGame->curPlayer, ply, entry.moveCode, moves, moveAmt);
+    }
+ 
+    int startAlpha = alpha;
+    int bestScore = -INF_SCORE;
+    Move bestMove = moves[0];
+    for (int i = 0; i < moveAmt; i++) {
+        GameData child = *pGame;
+        applyMove(&child, moves[i]);
+        int score = -alphaBeta(&child, pInfo, depth - 1, ply + 1, -beta, -alpha);
+ 
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = moves[i];
+        }
+ 
+        if (score >= beta) {
+            PROFILE_COUNT(PROF_CUTOFFS);
+            if (pInfo->useOrdering) {
+                storeCutoff(pInfo, pGame->curPlayer, ply, depth, moves[i]);
+            }
+            break;
+        }
+ 
+        if (score > alpha) {
+            alpha = score;
+            if (ply == 0) {
+                pInfo->bestMove = moves[i];
+            }
+        }
+    }
+ 
+    if (pInfo->pTable != NULL) {
+        entry.score = bestScore > WIN_SCORE - MAX_PLY ? bestScore + ply :
+                      bestScore < -(WIN_SCORE - MAX_PLY) ? bestScore - ply : bestScore;
+        entry.depth = depth;
+        entry.bound = bestScore >= beta ? TT_LOWER : bestScore <= startAlpha ? TT_UPPER : TT_EXACT;
+        entry.moveCode = encodeMove(bestMove);
+        storeTransTable(pInfo->pTable, key, entry);
+    }
+ 
+    return bestScore;
+}
+ 
+/**
+ * @brief Finds the best move for the current player.
+ * @details
+ *    The search is deepened one ply at a time (iterative deepening) so that
+ *    the killer moves and history scores from shallower iterations can order
+ *    the moves of the deeper ones. When ordering is enabled, the best move of
+ *    the previous iteration is searched first.
+ *
+ * @param pGame   Contains game data.
+ * @param depth   How many plies to search ahead.
+ * @param pInfo   Contains the search state, which is reset by this function
+ *                (except for useOrdering and pTable).
+ * @param pMove   Pointer to where the best move found is stored.
+ *
+ * @pre   The game is ongoing and 1 <= depth <= MAX_PLY.
+ *
+ * @return The amount of moves the current player has (if 0, nothing is
+ *         searched and pMove is not changed).
+ */
+int searchBestMove(GameData *pGame, int depth, SearchInfo *pInfo, Move *pMove) {
+    int useOrdering = pInfo->useOrdering;
+    TransTable *pTable = pInfo->pTable;
+    memset(pInfo, 0, sizeof(*pInfo));
+    pInfo->useOrdering = useOrdering;
+    pInfo->pTable = pTable;
+ 
+    Move moves[MAX_MOVE_AMT];
+    int moveAmt = generateMoves(pGame, moves);
+    if (moveAmt == 0) {
+        return 0;
+    }
+    Move bestMove = moves[0];
+ 
+    for (int curDepth = 1; curDepth <= depth; curDepth++) {
+        pInfo->bestMove = bestMove;
+        pInfo->bestScore = alphaBeta(pGame, pInfo, curDepth, 0, -INF_SCORE, INF_SCORE);
+        bestMove = pInfo->bestMove;
+ 
+        // stop once a forced win or loss has been found
+        if (pInfo->bestScore > WIN_SCORE - MAX_PLY || pInfo->bestScore < -(WIN_SCORE - MAX_PLY)) {
+            break;
+        }
+    }
+ 
+    *pMove = bestMove;
+    return moveAmt;
+}
+ 
+/**
+ * @brief
+ *    Compares how many nodes the search needs to reach each depth with and
+ *    without move ordering (and with a transposition table), starting from
+ *    the initial game data.
+ * @details
+ *    The table is cleared before each depth, unless it is shared with
+ *    other processes (see --shared-table), in which case it keeps what
+ *    earlier runs searched.
+ *
+ * @param maxDepth   The deepest depth to be searched.
+ *
+ * @return
+ *    0   if the benchmark was run.
+ *    1   otherwise.
+ */
+int runSearchBench(int maxDepth) {
+    GameData game;
+    initGameData(&game);
+    Move move;
+    TransTable table = {NULL, 0, NULL, 0};
+    if (gSharedTable == NULL && initTransTable(&table, gMemoryBudget) == 0) {
+        printf("ERROR: Could not reserve the transposition table!\n");
+        return 1;
+    }
+    SearchInfo *pInfo = malloc(sizeof(*pInfo));
+    if (pInfo == NULL) {
+        printf("ERROR: Could not reserve the search state!\n");
+        freeTransTable(&table);
+        return 1;
+    }
+ 
+    printf("%5s  %15s  %15s  %7s  %15s\n", "depth", "nodes (plain)", "nodes (ordered)", "ratio",
+           "nodes (+table)");
+    for (int depth = 1; depth <= maxDepth; depth++) {
+        pInfo->pTable = NULL;
+        pInfo->useOrdering = 0;
+        searchBestMove(&game, depth, pInfo, &move);
+        long long plainNodes = pInfo->nodes;
+ 
+        pInfo->useOrdering = 1;
+        searchBestMove(&game, depth, pInfo, &move);
+        long long orderedNodes = pInfo->nodes;
+ 
+        if (gSharedTable == NULL) {
+            memset(table.entries, 0, (table.mask + 1) * sizeof(TTEntry));
+        }
+        pInfo->pTable = gSharedTable != NULL ? gSharedTable : &table;
+        searchBestMove(&game, depth, pInfo, &move);
+        long long tableNodes = pInfo->nodes;
+ 
+        printf("%5d  %15lld  %15lld  %6.2fx  %15lld\n", depth, plainNodes, orderedNodes,
+               (double) plainNodes / orderedNodes, tableNodes);
+    }
+ 
+    freeTransTable(&table);
+    free(pInfo);
+    return 0;
+}
+ 
+/**
+ * @brief Gets the amount of processors available to the program.
+ *
+ * @return The amount of online processors (at least 1).
+ */
+int getCoreAmt(void) {
+    long coreAmt = sysconf(_SC_NPROCESSORS_ONLN);
+    return coreAmt < 1 ? 1 : (int) coreAmt;
+}
+ 
+/**
+ * @brief Generates the next number of a pseudorandom sequence (xorshift64*).
+ *
+ * @param pState   The state of the sequence, which must not be 0.
+ *
+ * @return A pseudorandom 64-bit number.
+ */
+uint64_t nextRandom(uint64_t *pState) {
+    *pState ^= *pState >> 12;
+    *pState ^= *pState << 25;
+    *pState ^= *pState >> 27;
+    return *pState * 0x2545F4914F6CDD1DULL;
+}
+ 
+/**
+ * @brief Mixes a number into a well-distributed, nonzero seed (splitmix64).
+ *
+ * @param value   The number to be mixed.
+ *
+ * @return A nonzero 64-bit seed.
+ */
+uint64_t mixSeed(uint64_t value) {
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    value ^= value >> 31;
+    return value == 0 ? 1 : value;
+}
+ 
+/**
+ * @brief Reserves the memory of an arena.
+ * @details
+ *    The whole budget is allocated at once, and allocations from the arena
+ *    just advance an offset into it (see arenaAlloc()), so no allocator calls
+ *    are made while the arena is used.
+ *
+ * @param pArena   The arena to be initialized.
+ * @param budget   The most bytes the arena can hand out.
+ *
+ * @return
+ *    1   if the memory was reserved.
+ *    0   otherwise.
+ */
+int initArena(Arena *pArena, size_t budget) {
+    memset(pArena, 0, sizeof(*pArena));
+    pArena->base = malloc(budget);
+    pArena->budget = pArena->base != NULL ? budget : 0;
+    return pArena->base != NULL;
+}
+ 
+/**
+ * @brief Allocates memory from an arena.
+ *
+ * @param pArena   The arena.
+ * @param size     The amount of bytes to be allocated.
+ *
+ * @return
+ *    Memory aligned to ARENA_ALIGN bytes   if the budget allows it.
+ *    NULL                                  otherwise.
+ */
+void *arenaAlloc(Arena *pArena, size_t size) {
+    size_t start = (pArena->used + ARENA_ALIGN - 1) & ~(size_t) (ARENA_ALIGN - 1);
+    if (start + size > pArena->budget) {
+        pArena->failAmt++;
+        return NULL;
+    }
+ 
+    pArena->used = start + size;
+    if (pArena->used > pArena->peak) {
+        pArena->peak = pArena->used;
+    }
+    pArena->allocAmt++;
+ 
+    return pArena->base + start;
+}
+ 
+/**
+ * @brief Frees everything allocated from an arena at once.
+ *
+ * @param pArena   The arena.
+ */
+void resetArena(Arena *pArena) {
+    pArena->used = 0;
+    pArena->resetAmt++;
+}
+ 
+/**
+ * @brief Releases the memory of an arena.
+ *
+ * @param pArena   The arena.
+ */
+void freeArena(Arena *pArena) {
+    free(pArena->base);
+    pArena->base = NULL;
+    pArena->budget = 0;
+    pArena->used = 0;
+}
+ 
+/**
+ * @brief Prints the statistics of an arena.
+ *
+ * @param name     What the arena is used for.
+ * @param pArena   The arena.
+ */
+void printArenaStats(char name[], Arena *pArena) {
+    printf("%s: %zu of %zu KiB peak, %ld allocations, %ld resets, %ld failed\n",
+           name, pArena->peak / 1024, pArena->budget / 1024,
+           pArena->allocAmt, pArena->resetAmt, pArena->failAmt);
+}
+ 
+/**
+ * @brief Writes a file so that it is either fully written or not changed.
+ * @details
+ *    The parts are written to a temporary file next to the file, which is
+ *    flushed to disk and then renamed over the file. Since a rename is
+ *    atomic, a crash leaves either the old or the new file, never a mix of
+ *    both. The directory is flushed too, so that the rename itself survives
+ *    a crash.
+ *
+ * @param path      The path of the file.
+ * @param parts     The parts of the file, in order.
+ * @param sizes     The size of each part in bytes.
+ * @param partAmt   The amount of parts.
+ *
+ * @return
+ *    1   if the file was written.
+ *    0   otherwise.
+ */
+int writeFileAtomically(char path[], const void *parts[], size_t sizes[], int partAmt) {
+    char tempPath[CHECKPOINT_PATH_LEN];
+    char dirPath[CHECKPOINT_PATH_LEN];
+    int written = snprintf(tempPath, sizeof(tempPath), "%s.tmp", path) < (int) sizeof(tempPath);
+    int fd = written ? open(tempPath, O_WRONLY | O_CREAT | O_TRUNC, 0644) : -1;
+    written = fd != -1;
+ 
+    for (int i = 0; i < partAmt && written; i++) {
+        const char *data = parts[i];
+        size_t left = sizes[i];
+        while (left > 0 && written) {
+            ssize_t amt = write(fd, data, left);
+            written = amt > 0;
+            data += written ? amt : 0;
+            left -= written ? (size_t) amt : 0;
+        }
+    }
+ 
+    if (fd != -1) {
+        written = fsync(fd) == 0 && close(fd) == 0 && written;
+        written = written && rename(tempPath, path) == 0;
+        if (!written) {
+            unlink(tempPath);
+        }
+    }
+ 
+    // the rename is only durable once the directory is flushed
+    char *slash = strrchr(path, '/');
+    snprintf(dirPath, sizeof(dirPath), "%.*s", slash != NULL ? (int) (slash - path) + 1 : 1,
+             slash != NULL ? path : ".");
+    int dirFd = written ? open(dirPath, O_RDONLY) : -1;
+    if (dirFd != -1) {
+        fsync(dirFd);
+        close(dirFd);
+    }
+ 
+    return written;
+}
+ 
+/**
+ * @brief Reserves the node table of a proof-number solver.
+ * @details
+ *    The table holds the largest power of two of entries that fits in the
+ *    budget. When two positions share an entry, the newer one replaces the
+ *    older one, so the solver never needs more memory than the budget.
+ *
+ * @param pSolver   The solver to be initialized.
+ * @param budget    The most bytes the table can take up.
+ *
+ * @return
+ *    1   if the memory was reserved.
+ *    0   otherwise.
+ */
+int initSolver(Solver *pSolver, size_t budget) {
+    size_t entryAmt = 1;
+    while (entryAmt * 2 * sizeof(PNEntry) <= budget) {
+        entryAmt *= 2;
+    }
+ 
+    // the table is mapped, so that it can be written to a checkpoint as is
+    memset(pSolver, 0, sizeof(*pSolver));
+    pSolver->mapSize = entryAmt * sizeof(PNEntry);
+    pSolver->mapping = mmap(NULL, pSolver->mapSize, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pSolver->mapping == MAP_FAILED) {
+        pSolver->mapping = NULL;
+        pSolver->mapSize = 0;
+    }
+    pSolver->entries = (PNEntry *) pSolver->mapping;
+    pSolver->mask = pSolver->entries != NULL ? entryAmt - 1 : 0;
+    return pSolver->entries != NULL;
+}
+ 
+/**
+ * @brief Releases the node table of a proof-number solver.
+ *
+ * @param pSolver   The solver.
+ */
+void freeSolver(Solver *pSolver) {
+    munmap(pSolver->mapping, pSolver->mapSize);
+    pSolver->mapping = NULL;
+    pSolver->mapSize = 0;
+    pSolver->entries = NULL;
+    pSolver->mask = 0;
+}
+ 
+/**
+ * @brief Writes the node table of a solver to its checkpoint file.
+ * @details
+ *    The table is written straight from its mapping after a header of
+ *    CHECKPOINT_HEADER_SIZE bytes, so that loadSolverCheckpoint() can map
+ *    it back at a page boundary without reading it.
+ *
+ * @param pSolver   The solver.
+ *
+ * @return
+ *    1   if the checkpoint was written.
+ *    0   otherwise.
+ */
+int saveSolverCheckpoint(Solver *pSolver) {
+    unsigned char header[CHECKPOINT_HEADER_SIZE] = {0};
+    SolverCheckpoint checkpoint = {SOLVER_CHECKPOINT_MAGIC, CHECKPOINT_VERSION, pSolver->rootKey,
+                                   pSolver->mask + 1, pSolver->nodes, pSolver->attacker, ROW, COL, gRules};
+    memcpy(header, &checkpoint, sizeof(checkpoint));
+ 
+    const void *parts[] = {header, pSolver->entries};
+    size_t sizes[] = {sizeof(header), (pSolver->mask + 1) * sizeof(PNEntry)};
+    return writeFileAtomically(pSolver->checkpointPath, parts, sizes, 2);
+}
+ 
+/**
+ * @brief Replaces the node table of a solver with the one in a checkpoint.
+ * @details
+ *    The checkpoint is mapped privately instead of read, so resuming takes
+ *    no time and pages are only loaded when they are used. Changes to the
+ *    table are not written back to the file.
+ *
+ * @param pSolver   The solver, whose checkpointPath and rootKey are set.
+ *
+ * @return
+ *    1   if the checkpoint was loaded.
+ *    0   if there is no checkpoint of the position under the same rules.
+ */
+int loadSolverCheckpoint(Solver *pSolver) {
+    SolverCheckpoint checkpoint;
+    struct stat fileStat;
+    unsigned char *mapping = MAP_FAILED;
+    int fd = open(pSolver->checkpointPath, O_RDONLY);
+ 
+    if (fd != -1 && fstat(fd, &fileStat) == 0 && fileStat.st_size > CHECKPOINT_HEADER_SIZE) {
+        mapping = mmap(NULL, fileStat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    }
+    if (fd != -1) {
+        close(fd);
+    }
+    if (mapping == MAP_FAILED) {
+        return 0;
+    }
+ 
+    memcpy(&checkpoint, mapping, sizeof(checkpoint));
+    uint64_t entryAmt = checkpoint.entryAmt;
+    if (memcmp(checkpoint.magic, SOLVER_CHECKPOINT_MAGIC, sizeof(checkpoint.magic)) != 0 ||
+        checkpoint.version != CHECKPOINT_VERSION || checkpoint.rootKey != pSolver->rootKey ||
+        checkpoint.row != ROW || checkpoint.col != COL || checkpoint.rules.sParity != gRules.sParity ||
+        checkpoint.rules.startRows != gRules.startRows || checkpoint.rules.pieceAmt != gRules.pieceAmt ||
+        entryAmt == 0 || (entryAmt & (entryAmt - 1)) != 0 ||
+        (uint64_t) fileStat.st_size != CHECKPOINT_HEADER_SIZE + entryAmt * sizeof(PNEntry)) {
+        munmap(mapping, fileStat.st_size);
+        return 0;
+    }
+ 
+    munmap(pSolver->mapping, pSolver->mapSize);
+    pSolver->mapping = mapping;
+    pSolver->mapSize = fileStat.st_size;
+    pSolver->entries = (PNEntry *) (mapping + CHECKPOINT_HEADER_SIZE);
+    pSolver->mask = entryAmt - 1;
+    pSolver->nodes = checkpoint.nodes;
+    pSolver->attacker = checkpoint.attacker;
+    return 1;
+}
+ 
+/**
+ * @brief Checks the limits of a solver and writes a checkpoint when due.
+ * @details
+ *    The clock is only read every PN_CHECK_NODE_AMT nodes, since reading it
+ *    costs more than visiting a node.
+ *
+ * @param pSolver   The solver.
+ *
+ * @return
+ *    1   if a limit was reached.
+ *    0   otherwise.
+ */
+int checkSolverLimits(Solver *pSolver) {
+    if (pSolver->maxNodes > 0 && pSolver->nodes >= pSolver->maxNodes) {
+        pSolver->aborted = 1;
+    } else if (pSolver->nodes >= pSolver->nextCheckNodes &&
+               (pSolver->deadline > 0 || pSolver->nextCheckpoint > 0)) {
+        pSolver->nextCheckNodes = pSolver->nodes + PN_CHECK_NODE_AMT;
+        double now = getTime();
+        pSolver->aborted = pSolver->deadline > 0 && now > pSolver->deadline;
+        if (pSolver->nextCheckpoint > 0 && now >= pSolver->nextCheckpoint) {
+            saveSolverCheckpoint(pSolver);
+            pSolver->nextCheckpoint = getTime() + gCheckpointInterval;
+        }
+    }
+ 
+    return pSolver->aborted;
+}
+ 
+/**
+ * @brief Adds two proof numbers, keeping PN_INF as infinity.
+ *
+ * @return The sum, or PN_INF if it would reach PN_INF.
+ */
+uint32_t addProofNumbers(uint32_t number1, uint32_t number2) {
+    return number1 >= PN_INF - number2 ? PN_INF : number1 + number2;
+}
+ 
+/**
+ * @brief Looks up the proof numbers of a position in the node table.
+ * @details
+ *    Proof numbers are stored as (phi, delta) from the point of view of the
+ *    player to move: phi is the proof number if the attacker is to move and
+ *    the disproof number otherwise, and delta is the other one. Positions
+ *    that are not in the table have not been searched yet, so both are 1.
+ *
+ * @param pSolver   The solver.
+ * @param key       The hash of the position.
+ * @param pPhi      Pointer to where phi is stored.
+ * @param pDelta    Pointer to where delta is stored.
+ */
+void lookUpProofNumbers(Solver *pSolver, uint64_t key, uint32_t *pPhi, uint32_t *pDelta) {
+    PNEntry *pEntry = &pSolver->entries[key & pSolver->mask];
+    if (pEntry->key == key) {
+        *pPhi = pEntry->phi;
+        *pDelta = pEntry->delta;
+    } else {
+        *pPhi = 1;
+        *pDelta = 1;
+    }
+}
+ 
+/**
+ * @brief Stores the proof numbers of a position in the node table.
+ *
+ * @param pSolver   The solver.
+ * @param key       The hash of the position.
+ * @param phi       See lookUpProofNumbers().
+ * @param delta     See lookUpProofNumbers().
+ */
+void storeProofNumbers(Solver *pSolver, uint64_t key, uint32_t phi, uint32_t delta) {
+    PNEntry *pEntry = &pSolver->entries[key & pSolver->mask];
+    pEntry->key = key;
+    pEntry->phi = phi;
+    pEntry->delta = delta;
+}
+ 
+/**
+ * @brief Gets the proof numbers of a position where no search is needed.
+ * @details
+ *    If the game is over, the position is proven (the attacker won) or
+ *    disproven (the defender won). If the player to move has no moves, the
+ *    position is disproven since the attacker cannot win from there.
+ *
+ * @param pGame      Contains game data.
+ * @param attacker   The player whose win is to be proven.
+ * @param moves      Array where the moves of the position are stored.
+ * @param pMoveAmt   Pointer to where the amount of moves is stored.
+ * @param pPhi       Pointer to where phi is stored if the position is solved.
+ * @param pDelta     Pointer to where delta is stored if the position is solved.
+ *
+ * @return
+ *    1   if the position is solved without searching.
+ *    0   otherwise.
+ */
+int getSolvedProofNumbers(GameData *pGame, int attacker, Move moves[], int *pMoveAmt,
+                          uint32_t *pPhi, uint32_t *pDelta) {
+    int over = checkGameStatus(pGame);
+    *pMoveAmt = over == GAME_ONGOING ? generateMoves(pGame, moves) : 0;
+    if (over == GAME_ONGOING && *pMoveAmt > 0) {
+        return 0;
+    }
+ 
+    // proven for the attacker, then converted to the player to move's view
+    int proven = over == attacker;
+    int attackerToMove = pGame->curPlayer == attacker;
+    *pPhi = proven == attackerToMove ? 0 : PN_INF;
+    *pDelta = proven == attackerToMove ? PN_INF : 0;
+    return 1;
+}
+ 
+/**
+ * @brief Searches a position with depth-first proof-number search (df-pn).
+ * @details
+ *    The position is searched until its phi or delta reaches its threshold.
+ *    Each time, the child with the smallest delta (the one closest to
+ *    proving the position for the player to move) is searched with
+ *    thresholds that make it return as soon as another child would be more
+ *    promising. Since pieces only move forward, the game has no cycles, so
+ *    the node table can safely share results between transpositions.
+ *
+ * @param pSolver      The solver.
+ * @param pGame        Contains game data.
+ * @param attacker     The player whose win is to be proven.
+ * @param thPhi        Threshold of phi.
+ * @param thDelta      Threshold of delta.
+ */
+void searchProofNumbers(Solver *pSolver, GameData *pGame, int attacker, uint32_t thPhi, uint32_t thDelta) {
+    Move moves[MAX_MOVE_AMT];
+    uint64_t keys[MAX_MOVE_AMT];
+    int moveAmt = 0;
+    uint32_t phi = 0;
+    uint32_t delta = 0;
+    uint64_t key = hashPackedPos(packPos(pGame));
+ 
+    pSolver->nodes++;
+    if (getSolvedProofNumbers(pGame, attacker, moves, &moveAmt, &phi, &delta)) {
+        storeProofNumbers(pSolver, key, phi, delta);
+        return;
+    }
+ 
+    for (int i = 0; i < moveAmt; i++) {
+        GameData child = *pGame;
+        applyMove(&child, moves[i]);
+        keys[i] = hashPackedPos(packPos(&child));
+    }
+ 
+    while (1) {
+        // phi is the smallest delta of the children, delta is the sum of their phi
+        int bestChild = 0;
+        uint32_t bestPhi = PN_INF;
+        uint32_t secondDelta = PN_INF;
+        phi = PN_INF;
+        delta = 0;
+        for (int i = 0; i < moveAmt; i++) {
+            uint32_t childPhi = 0;
+            uint32_t childDelta = 0;
+            lookUpProofNumbers(pSolver, keys[i], &childPhi, &childDelta);
+            delta = addProofNumbers(delta, childPhi);
+            if (childDelta < phi) {
+                secondDelta = phi;
+                phi = childDelta;
+                bestPhi = childPhi;
+                bestChild = i;
+            } else if (childDelta < secondDelta) {
+                secondDelta = childDelta;
+            }
+        }
+ 
+        storeProofNumbers(pSolver, key, phi, delta);
+        if (phi >= thPhi || delta >= thDelta || pSolver->aborted) {
+            return;
+        }
+ 
+        if (checkSolverLimits(pSolver)) {
+            return;
+        }
+ 
+        GameData child = *pGame;
+        applyMove(&child, moves[bestChild]);
+        uint32_t childThPhi = addProofNumbers(thDelta - delta, bestPhi);
+        uint32_t childThDelta = thPhi < addProofNumbers(secondDelta, 1) ? thPhi : addProofNumbers(secondDelta, 1);
+        searchProofNumbers(pSolver, &child, attacker, childThPhi, childThDelta);
+    }
+}
+ 
+/**
+ * @brief Tries to prove that a player can force a win from the given game data.
+ *
+ * @param pSolver    The solver, whose limits (maxNodes and deadline) apply.
+ * @param pGame      Contains game data.
+ * @param attacker   The player whose win is to be proven.
+ * @param pMove      Pointer to where the winning move is stored if the
+ *                   attacker is to move and the win is proven.
+ *
+ * @return
+ *    PN_WIN       if the attacker can force a win (and the winning move was
+ *                 found if the attacker is to move).
+ *    PN_DRAW      if the attacker cannot force a win.
+ *    PN_UNKNOWN   if neither was proven within the limits, or the winning
+ *                 move was lost from the node table.
+ */
+int proveWin(Solver *pSolver, GameData *pGame, int attacker, Move *pMove) {
+    uint32_t phi = 0;
+    uint32_t delta = 0;
+    uint64_t key = hashPackedPos(packPos(pGame));
+ 
+    pSolver->aborted = 0;
+    pSolver->attacker = attacker;
+    searchProofNumbers(pSolver, pGame, attacker, PN_INF, PN_INF);
+    lookUpProofNumbers(pSolver, key, &phi, &delta);
+ 
+    // convert back to the attacker's point of view
+    uint32_t proof = pGame->curPlayer == attacker ? phi : delta;
+    uint32_t disproof = pGame->curPlayer == attacker ? delta : phi;
+    if (pSolver->aborted || (proof != 0 && disproof != 0)) {
+        return PN_UNKNOWN;
+    } else if (disproof == 0) {
+        return PN_DRAW;
+    }
+ 
+    if (pGame->curPlayer != attacker) {
+        return PN_WIN;
+    }
+ 
+    // the winning move leads to a child that is disproven for the defender,
+    // unless its entry has since been replaced in the node table
+    Move moves[MAX_MOVE_AMT];
+    int moveAmt = generateMoves(pGame, moves);
+    for (int i = 0; i < moveAmt; i++) {
+        GameData child = *pGame;
+        applyMove(&child, moves[i]);
+        lookUpProofNumbers(pSolver, hashPackedPos(packPos(&child)), &phi, &delta);
+        if (delta == 0) {
+            *pMove = moves[i];
+            return PN_WIN;
+        }
+    }
+ 
+    return PN_UNKNOWN;
+}
+ 
+/**
+ * @brief Solves the given game data with proof-number search.
+ * @details
+ *    First, a win for the current player is proven or disproven. If it is
+ *    disproven, a win for the opponent (a loss) is proven or disproven. If
+ *    neither player can force a win, the game ends with a player having no
+ *    moves left with correct play.
+ *
+ * @param pSolver    The solver, whose limits (maxNodes and deadline) apply
+ *                   to the whole solve.
+ * @param pGame      Contains game data.
+ * @param pMove      Pointer to where the winning move is stored if the result
+ *                   is PN_WIN.
+ *
+ * @return PN_WIN, PN_LOSS or PN_DRAW from the current player's point of
+ *         view, or PN_UNKNOWN if the limits were reached first.
+ */
+int solvePosition(Solver *pSolver, GameData *pGame, Move *pMove) {
+    int opponent = switchPlayer(pGame->curPlayer);
+    int result = PN_DRAW;
+ 
+    // a table resumed while proving a loss is already past the first step
+    if (pSolver->attacker != opponent) {
+        result = proveWin(pSolver, pGame, pGame->curPlayer, pMove);
+        if (result == PN_DRAW) {
+            // the node table is cleared since proof numbers depend on the attacker
+            memset(pSolver->entries, 0, (pSolver->mask + 1) * sizeof(PNEntry));
+        }
+    }
+ 
+    if (result == PN_DRAW) {
+        switch (proveWin(pSolver, pGame, opponent, pMove)) {
+            case PN_WIN: result = PN_LOSS; break;
+            case PN_UNKNOWN: result = PN_UNKNOWN; break;
+        }
+    }
+ 
+    return result;
+}
+ 
+/**
+ * @brief Plays a list of moves (ex. "B6-B5 B2-B3") from the start of a game.
+ *
+ * @param pGame   Contains game data, which is initialized first.
+ * @param text    The moves, separated by spaces or commas.
+ *
+ * @return
+ *    1   if every move was legal.
+ *    0   otherwise.
+ */
+int playMoveList(GameData *pGame, char text[]) {
+    initGameData(pGame);
+ 
+    while (*text != '\0') {
+        if (isspace((unsigned char) *text) || *text == ',') {
+            text++;
+            continue;
+        }
+ 
+        Move move = {{0, 0}, {0, 0}, 0};
+        if (parsePos(&text, &move.src) == 0 || *text++ != '-' || parsePos(&text, &move.dest) == 0) {
+            return 0;
+        }
+ 
+        Move moves[MAX_MOVE_AMT];
+        int moveAmt = generateMoves(pGame, moves);
+        int found = 0;
+        for (int i = 0; i < moveAmt && !found; i++) {
+            if (isSameMove(moves[i], move) && checkGameStatus(pGame) == GAME_ONGOING) {
+                applyMove(pGame, moves[i]);
+                found = 1;
+            }
+        }
+ 
+        if (!found) {
+            return 0;
+        }
+    }
+ 
+    return 1;
+}
+ 
+/**
+ * @brief Solves the position after a list of moves and prints the result.
+ * @details
+ *    If checkpoints are enabled, the node table is written to
+ *    solve-<hash>.ckpt every gCheckpointInterval seconds and when a limit
+ *    is reached, and a later solve of the same position resumes from it.
+ *    The checkpoint is removed once the position is solved.
+ *
+ * @param moveList    The moves played from the start (see playMoveList()).
+ * @param maxNodes    The most nodes the solve may visit (0 for no limit).
+ * @param timeLimit   How many seconds the solve may take (0 for no limit).
+ *
+ * @return
+ *    0   if the position was solved.
+ *    1   otherwise.
+ */
+int runSolver(char moveList[], long long maxNodes, double timeLimit) {
+    char *resultNames[] = {"unknown", "win", "loss", "draw"};
+    GameData game;
+    if (playMoveList(&game, moveList) == 0) {
+        printf("ERROR: The moves are not legal!\n");
+        return 1;
+    }
+ 
+    Solver solver;
+    if (initSolver(&solver, gMemoryBudget) == 0) {
+        printf("ERROR: Could not reserve the node table!\n");
+        return 1;
+    }
+    solver.rootKey = hashPackedPos(packPos(&game));
+    if (gCheckpointInterval > 0) {
+        snprintf(solver.checkpointPath, sizeof(solver.checkpointPath), "solve-%016llx.ckpt",
+                 (unsigned long long) solver.rootKey);
+        solver.nextCheckpoint = getTime() + gCheckpointInterval;
+        if (loadSolverCheckpoint(&solver)) {
+            printf("Resumed from %s after %lld nodes.\n", solver.checkpointPath, solver.nodes);
+        }
+    }
+    solver.maxNodes = maxNodes > 0 ? solver.nodes + maxNodes : 0;
+    solver.deadline = timeLimit > 0 ? getTime() + timeLimit : 0;
+ 
+    Move move = {{0, 0}, {0, 0}, 0};
+    double startTime = getTime();
+    int result = solvePosition(&solver, &game, &move);
+    double elapsed = getTime() - startTime;
+ 
+    if (solver.checkpointPath[0] != '\0' && result == PN_UNKNOWN) {
+        if (saveSolverCheckpoint(&solver)) {
+            printf("Checkpoint written to %s.\n", solver.checkpointPath);
+        } else {
+            printf("ERROR: Could not write %s!\n", solver.checkpointPath);
+        }
+    } else if (solver.checkpointPath[0] != '\0') {
+        unlink(solver.checkpointPath);
+    }
+ 
+    displayBoard(game.gameBoard);
+    printf("\n%s to move: %s", game.curPlayer == 1 ? "Alpha" : "Beta", resultNames[result]);
+    if (result == PN_WIN) {
+        char buffer[8];
+        formatMove(move, buffer);
+        printf(" (%s)", buffer);
+    }
+    printf("\n%lld nodes in %.3f s (node table of %llu entries).\n", solver.nodes, elapsed,
+           (unsigned long long) solver.mask + 1);
+ 
+    freeSolver(&solver);
+    return result == PN_UNKNOWN;
+}
+ 
+/**
+ * @brief Writes the header of a game archive.
+ * @details
+ *    The magic is followed by ARCHIVE_VERSION, the board size and the rules
+ *    the games are played under (see gRules), one byte each, so that the
+ *    games are never read under other rules.
+ *
+ * @param header   Array of ARCHIVE_HEADER_SIZE bytes where the header is stored.
+ * @param magic    ARCHIVE_MAGIC or COMPRESSED_ARCHIVE_MAGIC.
+ */
+void writeArchiveHeader(unsigned char header[], char magic[]) {
+    memcpy(header, magic, strlen(magic));
+    header[4] = ARCHIVE_VERSION;
+    header[5] = ROW;
+    header[6] = COL;
+    header[7] = (unsigned char) gRules.sParity;
+    header[8] = (unsigned char) gRules.startRows;
+    header[9] = (unsigned char) gRules.pieceAmt;
+}
+ 
+/**
+ * @brief Reads the next game of a game archive.
+ * @details
+ *    A game archive starts with a header (see writeArchiveHeader()), which
+ *    is followed by the games one after another. Each game is stored as its amount of plies (1 byte),
+ *    its result (1 byte, GAME_ONGOING if neither player won), and then one
+ *    byte per ply as encoded by encodeMove().
+ *
+ * @param data      The contents of the archive.
+ * @param size      The size of data in bytes.
+ * @param pOffset   Pointer to the offset of the next game, which is advanced
+ *                  past the game that is read.
+ * @param pRecord   Pointer to where the game is stored. Its moves point
+ *                  inside data.
+ *
+ * @return
+ *    1   if a game was read.
+ *    0   if there are no more games (or the last game is cut off).
+ */
+int readArchiveGame(unsigned char data[], long size, long *pOffset, GameRecord *pRecord) {
+    if (*pOffset + 2 > size || *pOffset + 2 + data[*pOffset] > size) {
+        return 0;
+    }
+ 
+    pRecord->plyAmt = data[*pOffset];
+    pRecord->result = data[*pOffset + 1];
+    pRecord->moves = data + *pOffset + 2;
+    *pOffset += 2 + pRecord->plyAmt;
+ 
+    return 1;
+}
+ 
+/**
+ * @brief Replays an archived game, checking every move against the rules.
+ * @details
+ *    Every move must be made by the current player onto a legal square that
+ *    is not occupied by one of their pieces, and captures must happen on S
+ *    squares, just like playerSelectPiece() and playerMovePiece() enforce.
+ *    No moves may follow the end of the game, and the recorded result must
+ *    match checkGameStatus() after the last move. A game recorded without a
+ *    winner must end with the current player having no moves left.
+ *
+ *    checkGameStatus() is only called after moves that can end the game,
+ *    which are captures and moves onto the opponent's starting positions.
+ *
+ * @param pRecord   The archived game.
+ * @param pPly      Pointer to where the ply of the first problem is stored
+ *                  (the amount of plies if the problem is the result).
+ *
+ * @return VERDICT_OK if the game is valid, or the first problem found.
+ */
+int validateGame(GameRecord *pRecord, int *pPly) {
+    GameData game;
+    initGameData(&game);
+    int over = GAME_ONGOING;
+ 
+    for (int i = 0; i < pRecord->plyAmt; i++) {
+        Move move;
+        *pPly = i;
+ 
+        if (over != GAME_ONGOING) {
+            return VERDICT_MOVE_AFTER_END;
+        }
+        if (decodeMove(&game, pRecord->moves[i], &move) == 0) {
+            return VERDICT_BAD_CODE;
+        }
+        if (isPosAvailable(&game, move.src) != 0) {
+            return VERDICT_NOT_OWN_PIECE;
+        }
+        if (isMoveLegal(game.curPlayer, move.src, move.dest) == 0) {
+            return VERDICT_ILLEGAL_MOVE;
+        }
+ 
+        int posIsAvailable = isPosAvailable(&game, move.dest);
+        if (posIsAvailable == 0) {
+            return VERDICT_OWN_CAPTURE;
+        }
+        if (posIsAvailable == 2 && isSquareS(move.dest) == 0) {
+            return VERDICT_NOT_S_SQUARE;
+        }
+ 
+        // fast path: a move that neither captures nor lands on the
+        // opponent's starting positions cannot end the game
+        int mayEndGame = move.type == 2 ||
+                         (game.curPlayer == 1 ? isPosBetaStart(move.dest) : isPosAlphaStart(move.dest));
+        applyMove(&game, move);
+        if (mayEndGame) {
+            over = checkGameStatus(&game);
+        }
+    }
+ 
+    *pPly = pRecord->plyAmt;
+    if (over != pRecord->result) {
+        return VERDICT_WRONG_RESULT;
+    }
+ 
+    Move moves[MAX_MOVE_AMT];
+    if (over == GAME_ONGOING && generateMoves(&game, moves) > 0) {
+        return VERDICT_WRONG_RESULT; // the game was not finished
+    }
+ 
+    return VERDICT_OK;
+}
+ 
+/**
+ * @brief Starts encoding with a range coder.
+ *
+ * @param pCoder   The range coder.
+ * @param data     Array where the encoded bytes are stored.
+ */
+void initRangeEncoder(RangeCoder *pCoder, unsigned char data[]) {
+    pCoder->low = 0;
+    pCoder->range = UINT32_MAX;
+    pCoder->code = 0;
+    pCoder->data = data;
+    pCoder->size = 0;
+    pCoder->capacity = 0;
+}
+ 
+/**
+ * @brief Starts decoding bytes encoded by a range coder.
+ *
+ * @param pCoder   The range coder.
+ * @param data     The encoded bytes.
+ * @param size     The amount of encoded bytes.
+ */
+void initRangeDecoder(RangeCoder *pCoder, unsigned char data[], long size) {
+    pCoder->low = 0;
+    pCoder->range = UINT32_MAX;
+    pCoder->code = 0;
+    pCoder->data = data;
+    pCoder->size = 0;
+    pCoder->capacity = size;
+    for (int i = 0; i < 4; i++) {
+        pCoder->code = (pCoder->code << 8) | (pCoder->size < size ? data[pCoder->size++] : 0);
+    }
+}
+ 
+/**
+ * @brief Shifts out the top bytes of a range coder that can no longer change.
+ * @details
+ *    This is a carry-less range coder: when the top byte of the low end of
+ *    the range is settled, it is shifted out. When the range becomes too
+ *    small while the top byte is not settled yet, the range is cut down so
+ *    that it is, which costs a little precision but means a carry never has
+ *    to be propagated into bytes that were already written.
+ *
+ * @param pCoder   The range coder.
+ * @param decode   1 if decoding, 0 if encoding.
+ */
+void normalizeRange(RangeCoder *pCoder, int decode) {
+    while (1) {
+        if ((pCoder->low ^ (pCoder->low + pCoder->range)) >= RANGE_TOP) {
+            if (pCoder->range >= RANGE_BOTTOM) {
+                break;
+            }
+            pCoder->range = -pCoder->low & (RANGE_BOTTOM - 1);
+        }
+ 
+        if (decode) {
+            unsigned char next = pCoder->size < pCoder->capacity ? pCoder->data[pCoder->size++] : 0;
+            pCoder->code = (pCoder->code << 8) | next;
+        } else {
+            pCoder->data[pCoder->size++] = (unsigned char) (pCoder->low >> 24);
+        }
+        pCoder->low <<= 8;
+        pCoder->range <<= 8;
+    }
+}
+ 
+/**
+ * @brief Writes the last bytes of a range coder once every symbol is encoded.
+ *
+ * @param pCoder   The range coder.
+ */
+void flushRangeEncoder(RangeCoder *pCoder) {
+    for (int i = 0; i < 4; i++) {
+        pCoder->data[pCoder->size++] = (unsigned char) (pCoder->low >> 24);
+        pCoder->low <<= 8;
+    }
+}
+ 
+/**
+ * @brief Resets the move model to every move being equally likely.
+ *
+ * @param pModel   The move model.
+ */
+void initMoveModel(MoveModel *pModel) {
+    for (int i = 0; i <= MAX_MOVE_AMT; i++) {
+        for (int j = 0; j < MAX_MOVE_AMT; j++) {
+            pModel->freqs[i][j] = 1;
+        }
+        pModel->totals[i] = i;
+    }
+}
+ 
+/**
+ * @brief Makes a move more likely to be predicted by the move model.
+ * @details
+ *    Once the frequencies of a context add up to MODEL_FREQ_LIMIT, they
+ *    are halved, so that recent games count more than old ones.
+ *
+ * @param pModel    The move model.
+ * @param moveAmt   The amount of legal moves (the context).
+ * @param index     The index of the move that was played.
+ */
+void updateMoveModel(MoveModel *pModel, int moveAmt, int index) {
+    uint16_t *freqs = pModel->freqs[moveAmt];
+    freqs[index] += MODEL_FREQ_STEP;
+    pModel->totals[moveAmt] += MODEL_FREQ_STEP;
+ 
+    if (pModel->totals[moveAmt] > MODEL_FREQ_LIMIT) {
+        pModel->totals[moveAmt] = 0;
+        for (int i = 0; i < moveAmt; i++) {
+            freqs[i] = (uint16_t) ((freqs[i] + 1) / 2);
+            pModel->totals[moveAmt] += freqs[i];
+        }
+    }
+}
+ 
+/**
+ * @brief Encodes the index of a move in the list of legal moves.
+ * @details
+ *    The amount of legal moves is used as the context of the model. When
+ *    there is a single legal move, nothing needs to be encoded.
+ *
+ * @param pCoder    The range coder.
+ * @param pModel    The move model.
+ * @param moveAmt   The amount of legal moves.
+ * @param index     The index of the move that was played.
+ */
+void encodeMoveIndex(RangeCoder *pCoder, MoveModel *pModel, int moveAmt, int index) {
+    if (moveAmt > 1) {
+        uint32_t cumFreq = 0;
+        for (int i = 0; i < index; i++) {
+            cumFreq += pModel->freqs[moveAmt][i];
+        }
+ 
+        pCoder->range /= pModel->totals[moveAmt];
+        pCoder->low += cumFreq * pCoder->range;
+        pCoder->range *= pModel->freqs[moveAmt][index];
+        normalizeRange(pCoder, 0);
+        updateMoveModel(pModel, moveAmt, index);
+    }
+}
+ 
+/**
+ * @brief Decodes the index of a move encoded by encodeMoveIndex().
+ *
+ * @param pCoder    The range coder.
+ * @param pModel    The move model.
+ * @param moveAmt   The amount of legal moves.
+ *
+ * @return The index of the move in the list of legal moves.
+ */
+int decodeMoveIndex(RangeCoder *pCoder, MoveModel *pModel, int moveAmt) {
+    int index = 0;
+ 
+    if (moveAmt > 1) {
+        pCoder->range /= pModel->totals[moveAmt];
+        uint32_t target = (pCoder->code - pCoder->low) / pCoder->range;
+        uint32_t cumFreq = 0;
+        while (index < moveAmt - 1 && cumFreq + pModel->freqs[moveAmt][index] <= target) {
+            cumFreq += pModel->freqs[moveAmt][index];
+            index++;
+        }
+ 
+        pCoder->low += cumFreq * pCoder->range;
+        pCoder->range *= pModel->freqs[moveAmt][index];
+        normalizeRange(pCoder, 1);
+        updateMoveModel(pModel, moveAmt, index);
+    }
+ 
+    return index;
+}
+ 
+/**
+ * @brief Compresses a block of games, which must all be valid.
+ * @details
+ *    Each game is replayed, and every move is encoded as its index in the
+ *    list of legal moves generated by generateMoves(). The amount of plies
+ *    and the result are not stored: a valid game goes on until it is over or
+ *    the current player has no moves left, and its result is the one
+ *    checkGameStatus() gives at that point.
+ *
+ * @param data      The archive.
+ * @param size      The size of the archive.
+ * @param pOffset   Pointer to the offset of the first game of the block,
+ *                  which is moved past the last one.
+ * @param gameAmt   The amount of games in the block.
+ * @param out       Array where the compressed block is stored.
+ *
+ * @pre   out can hold at least gameAmt * MAX_PLY * 2 + 8 bytes.
+ *
+ * @return The size of the compressed block in bytes.
+ */
+long compressArchiveBlock(unsigned char data[], long size, long *pOffset, long gameAmt, unsigned char out[]) {
+    RangeCoder coder;
+    MoveModel model;
+    GameRecord record;
+    initRangeEncoder(&coder, out);
+    initMoveModel(&model);
+ 
+    for (long i = 0; i < gameAmt && readArchiveGame(data, size, pOffset, &record); i++) {
+        GameData game;
+        initGameData(&game);
+        for (int j = 0; j < record.plyAmt; j++) {
+            Move moves[MAX_MOVE_AMT];
+            int moveAmt = generateMoves(&game, moves);
+            int index = 0;
+            while (encodeMove(moves[index]) != record.moves[j]) {
+                index++;
+            }
+ 
+            encodeMoveIndex(&coder, &model, moveAmt, index);
+            applyMove(&game, moves[index]);
+        }
+    }
+ 
+    flushRangeEncoder(&coder);
+    return coder.size;
+}
+ 
+/**
+ * @brief Decompresses a block of games compressed by compressArchiveBlock().
+ *
+ * @param data      The compressed block.
+ * @param size      The size of the compressed block.
+ * @param gameAmt   The amount of games in the block.
+ * @param out       Array where the games are stored in archive format.
+ * @param capacity  The size of out in bytes.
+ *
+ * @return The size of the games in archive format in bytes, or -1 if they
+ *         do not fit in out (the block is damaged).
+ */
+long decompressArchiveBlock(unsigned char data[], long size, long gameAmt, unsigned char out[], long capacity) {
+    RangeCoder coder;
+    MoveModel model;
+    long outSize = 0;
+    initRangeDecoder(&coder, data, size);
+    initMoveModel(&model);
+ 
+    for (long i = 0; i < gameAmt; i++) {
+        GameData game;
+        unsigned char codes[MAX_PLY];
+        int plyAmt = 0;
+        int over = GAME_ONGOING;
+        initGameData(&game);
+ 
+        Move moves[MAX_MOVE_AMT];
+        int moveAmt = generateMoves(&game, moves);
+        while (over == GAME_ONGOING && moveAmt > 0 && plyAmt < MAX_PLY) {
+            Move move = moves[decodeMoveIndex(&coder, &model, moveAmt)];
+            codes[plyAmt++] = encodeMove(move);
+ 
+            // as in validateGame(), only these moves can end the game
+            int mayEndGame = move.type == 2 ||
+                             (game.curPlayer == 1 ? isPosBetaStart(move.dest) : isPosAlphaStart(move.dest));
+            applyMove(&game, move);
+            over = mayEndGame ? checkGameStatus(&game) : GAME_ONGOING;
+            moveAmt = generateMoves(&game, moves);
+        }
+ 
+        if (outSize + 2 + plyAmt > capacity) {
+            return -1;
+        }
+        out[outSize] = (unsigned char) plyAmt;
+        out[outSize + 1] = (unsigned char) over;
+        memcpy(out + outSize + 2, codes, plyAmt);
+        outSize += 2 + plyAmt;
+    }
+ 
+    return outSize;
+}
+ 
+/**
+ * @brief Decompresses the blocks claimed by a thread.
+ *
+ * @param arg   Pointer to the DecompressJob shared by every thread.
+ *
+ * @return NULL.
+ */
+void *runDecompressJob(void *arg) {
+    DecompressJob *pJob = arg;
+    gRules = pJob->rules; // the rules are per thread
+    long block = 0;
+ 
+    while ((block = __atomic_fetch_add(&pJob->nextBlock, 1, __ATOMIC_RELAXED)) < pJob->blockAmt) {
+        ArchiveBlock *pBlock = &pJob->blocks[block];
+        long size = decompressArchiveBlock(pJob->data + pBlock->offset, pBlock->size, pBlock->gameAmt,
+                                           pJob->out + pBlock->outOffset, pBlock->outSize);
+        if (size != pBlock->outSize) {
+            __atomic_store_n(&pJob->failed, 1, __ATOMIC_RELAXED);
+        }
+    }
+ 
+    return NULL;
+}
+ 
+/**
+ * @brief Reads the header of the next block of a compressed archive.
+ *
+ * @param data      The compressed archive.
+ * @param size      The size of the compressed archive.
+ * @param pOffset   Pointer to the offset of the next block, which is
+ *                  advanced past the block that is read.
+ * @param pBlock    Pointer to where the block is stored (except outOffset).
+ *
+ * @return
+ *    1   if a block was read.
+ *    0   if there are no more blocks, or the block is damaged.
+ */
+int readArchiveBlock(unsigned char data[], long size, long *pOffset, ArchiveBlock *pBlock) {
+    uint32_t header[3];
+    if (*pOffset + (long) sizeof(header) > size) {
+        return 0;
+    }
+ 
+    memcpy(header, data + *pOffset, sizeof(header));
+    if (header[0] > COMPRESS_BLOCK_AMT || header[1] > header[0] * (MAX_PLY + 2) ||
+        *pOffset + (long) sizeof(header) + header[2] > size) {
+        return 0;
+    }
+ 
+    pBlock->offset = *pOffset + sizeof(header);
+    pBlock->size = header[2];
+    pBlock->gameAmt = header[0];
+    pBlock->outSize = header[1];
+    *pOffset = pBlock->offset + pBlock->size;
+ 
+    return 1;
+}
+ 
+/**
+ * @brief Indexes the blocks of a compressed archive.
+ *
+ * @param data       The compressed archive.
+ * @param size       The size of the compressed archive.
+ * @param pBlockAmt  Pointer to where the amount of blocks is stored.
+ *
+ * @return The blocks (to be freed), or NULL if the archive is cut off.
+ */
+ArchiveBlock *indexArchiveBlocks(unsigned char data[], long size, long *pBlockAmt) {
+    long capacity = 64;
+    long blockAmt = 0;
+    long offset = ARCHIVE_HEADER_SIZE;
+    long outOffset = ARCHIVE_HEADER_SIZE;
+    ArchiveBlock *blocks = malloc(capacity * sizeof(ArchiveBlock));
+ 
+    while (blocks != NULL && offset < size) {
+        if (blockAmt == capacity) {
+            capacity *= 2;
+            blocks = realloc(blocks, capacity * sizeof(ArchiveBlock));
+        }
+ 
+        if (readArchiveBlock(data, size, &offset, &blocks[blockAmt]) == 0) {
+            free(blocks);
+            return NULL;
+        }
+        blocks[blockAmt].outOffset = outOffset;
+        outOffset += blocks[blockAmt++].outSize;
+    }
+ 
+    *pBlockAmt = blockAmt;
+    return blocks;
+}
+ 
+/**
+ * @brief Decompresses a compressed archive into memory on every core.
+ * @details
+ *    The blocks are decoded independently, each thread claiming the next
+ *    block that is left, into a mapping that holds the archive in its
+ *    usual format.
+ *
+ * @param data    The compressed archive.
+ * @param size    The size of the compressed archive.
+ * @param pSize   Pointer to where the size of the archive is stored.
+ *
+ * @return The archive (to be closed with closeArchive()), or NULL if the
+ *         compressed archive is damaged.
+ */
+unsigned char *decompressArchive(unsigned char data[], long size, long *pSize) {
+    DecompressJob job = {0};
+    job.data = data;
+    job.blocks = indexArchiveBlocks(data, size, &job.blockAmt);
+    if (job.blocks == NULL) {
+        return NULL;
+    }
+ 
+    long outSize = job.blockAmt > 0 ? job.blocks[job.blockAmt - 1].outOffset + job.blocks[job.blockAmt - 1].outSize
+                                    : ARCHIVE_HEADER_SIZE;
+    job.out = mmap(NULL, outSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (job.out == MAP_FAILED) {
+        free(job.blocks);
+        return NULL;
+    }
+    // the rules are the same as those of the compressed archive
+    memcpy(job.out, data, ARCHIVE_HEADER_SIZE);
+    memcpy(job.out, ARCHIVE_MAGIC, strlen(ARCHIVE_MAGIC));
+    job.rules = gRules;
+ 
+    int threadAmt = getCoreAmt() < MAX_THREAD_AMT ? getCoreAmt() : MAX_THREAD_AMT;
+    pthread_t threads[MAX_THREAD_AMT];
+    for (int i = 0; i < threadAmt; i++) {
+        pthread_create(&threads[i], NULL, runDecompressJob, &job);
+    }
+    for (int i = 0; i < threadAmt; i++) {
+        pthread_join(threads[i], NULL);
+    }
+ 
+    free(job.blocks);
+    if (job.failed) {
+        munmap(job.out, outSize);
+        return NULL;
+    }
+ 
+    *pSize = outSize;
+    return job.out;
+}
+ 
+/**
+ * @brief Maps the file of a game archive, compressed or not, into memory.
+ * @details
+ *    The file is mapped read-only instead of read, so that it does not need
+ *    to fit in memory and pages are only loaded when they are used. The file
+ *    is checked to start with ARCHIVE_MAGIC or COMPRESSED_ARCHIVE_MAGIC, and
+ *    to be written under the same rules (see writeArchiveHeader()).
+ *
+ * @param path    The path of the archive.
+ * @param pSize   Pointer to where the size of the file is stored.
+ *
+ * @return
+ *    The mapped file (to be closed with closeArchive())   if it was mapped.
+ *    NULL                                                  otherwise (an
+ *                                                          error is printed).
+ */
+unsigned char *mapArchiveFile(char path[], long *pSize) {
+    unsigned char *data = NULL;
+    unsigned char header[ARCHIVE_HEADER_SIZE];
+    struct stat fileStat;
+    int fd = open(path, O_RDONLY);
+ 
+    if (fd != -1 && fstat(fd, &fileStat) == 0 && fileStat.st_size >= ARCHIVE_HEADER_SIZE) {
+        data = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            data = NULL;
+        } else if (memcmp(data, ARCHIVE_MAGIC, strlen(ARCHIVE_MAGIC)) != 0 &&
+                   memcmp(data, COMPRESSED_ARCHIVE_MAGIC, strlen(COMPRESSED_ARCHIVE_MAGIC)) != 0) {
+            munmap(data, fileStat.st_size);
+            data = NULL;
+        }
+    }
+    if (fd != -1) {
+        close(fd);
+    }
+    if (data == NULL) {
+        printf("ERROR: %s is not a game archive!\n", path);
+        return NULL;
+    }
+ 
+    writeArchiveHeader(header, ARCHIVE_MAGIC);
+    if (memcmp(data + 4, header + 4, 3) != 0) {
+        printf("ERROR: %s was written by another version of the game or for another board size!\n", path);
+    } else if (memcmp(data + 7, header + 7, 3) != 0) {
+        printf("ERROR: %s was written under the rules %s:%d:%d (see --rules)!\n", path,
+               data[7] ? "opposite" : "same", data[8], data[9]);
+    } else {
+        madvise(data, fileStat.st_size, MADV_SEQUENTIAL);
+        *pSize = fileStat.st_size;
+        return data;
+    }
+ 
+    munmap(data, fileStat.st_size);
+    return NULL;
+}
+ 
+/**
+ * @brief Maps a game archive into memory.
+ * @details
+ *    See mapArchiveFile(). A compressed archive (see runCompressor()) is
+ *    decompressed into memory instead, so that every mode can read both
+ *    kinds of archives.
+ *
+ * @param path    The path of the archive.
+ * @param pSize   Pointer to where the size of the archive is stored.
+ *
+ * @return
+ *    The mapped archive (to be closed with closeArchive())   if it was mapped.
+ *    NULL                                                     otherwise.
+ */
+unsigned char *openArchive(char path[], long *pSize) {
+    long fileSize = 0;
+    unsigned char *data = mapArchiveFile(path, &fileSize);
+ 
+    if (data != NULL && memcmp(data, COMPRESSED_ARCHIVE_MAGIC, strlen(COMPRESSED_ARCHIVE_MAGIC)) == 0) {
+        unsigned char *compressed = data;
+        data = decompressArchive(compressed, fileSize, pSize);
+        munmap(compressed, fileSize);
+    } else if (data != NULL) {
+        *pSize = fileSize;
+    }
+ 
+    if (data == NULL && fileSize > 0) {
+        printf("ERROR: %s is damaged!\n", path);
+    }
+    return data;
+}
+ 
+/**
+ * @brief Unmaps a game archive mapped by openArchive().
+ *
+ * @param data   The mapped archive.
+ * @param size   The size of the archive.
+ */
+void closeArchive(unsigned char data[], long size) {
+    munmap(data, size);
+}
+ 
+/**
+ * @brief Plays a single game of the computer against itself.
+ * @details
+ *    Both players use searchBestMove() at the given depth, but a move is
+ *    chosen randomly for the first few plies and then with a small chance, so
+ *    that the games are varied. The game is stopped if the current player has
+ *    no moves left, in which case the result is GAME_ONGOING.
+ *
+ * @param seed    The seed of the random choices.
+ * @param depth   How many plies the players search ahead.
+ * @param pInfo   Contains the search state.
+ * @param codes   Array where the encoded moves are stored.
+ * @param pResult Pointer to where the result of the game is stored.
+ *
+ * @pre   codes can hold at least MAX_PLY elements.
+ *
+ * @return The amount of plies played.
+ */
+int playSelfPlayGame(uint64_t seed, int depth, SearchInfo *pInfo, unsigned char codes[], int *pResult) {
+    GameData game;
+    initGameData(&game);
+    uint64_t randomState = seed;
+    int plyAmt = 0;
+    int over = GAME_ONGOING;
+ 
+    while (over == GAME_ONGOING) {
+        Move moves[MAX_MOVE_AMT];
+        int moveAmt = generateMoves(&game, moves);
+        if (moveAmt == 0) {
+            break;
+        }
+ 
+        Move move;
+        if (plyAmt < SELFPLAY_RANDOM_PLY || nextRandom(&randomState) % 100 < SELFPLAY_RANDOM_PCT) {
+            move = moves[nextRandom(&randomState) % moveAmt];
+        } else {
+            searchBestMove(&game, depth, pInfo, &move);
+        }
+ 
+        codes[plyAmt++] = encodeMove(move);
+        applyMove(&game, move);
+        over = checkGameStatus(&game);
+    }
+ 
+    *pResult = over;
+    return plyAmt;
+}
+ 
+/**
+ * @brief Plays a range of self-play games, storing them in archive format.
+ *
+ * @param arg   Pointer to the SelfPlayJob of the thread.
+ *
+ * @return NULL.
+ */
+void *runSelfPlayJob(void *arg) {
+    SelfPlayJob *pJob = arg;
+    gRules = pJob->rules; // the rules are per thread
+ 
+    for (long i = pJob->nextGame; i < pJob->endGame; i++) {
+        // the search state only lives for one game
+        SearchInfo *pInfo = arenaAlloc(&pJob->scratch, sizeof(*pInfo));
+        if (pInfo == NULL) {
+            break;
+        }
+        pInfo->useOrdering = 1;
+        pInfo->pTable = NULL; // a table shared with other runs would make the archive differ between runs
+ 
+        int result = GAME_ONGOING;
+        unsigned char *record = pJob->data + pJob->size;
+        int plyAmt = playSelfPlayGame(mixSeed(pJob->seed ^ (uint64_t) i), pJob->depth,
+                                      pInfo, record + 2, &result);
+        record[0] = (unsigned char) plyAmt;
+        record[1] = (unsigned char) result;
+        resetArena(&pJob->scratch);
+ 
+        // a checkpoint may be written from the finished games at any time
+        __atomic_store_n(&pJob->size, pJob->size + 2 + plyAmt, __ATOMIC_RELEASE);
+    }
+ 
+    __atomic_store_n(&pJob->finished, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+ 
+/**
+ * @brief Prepares a self-play job to play its share of the games.
+ * @details
+ *    The games are written to a mapping that can hold the longest possible
+ *    games, which only takes up memory as it is used, so that it never has
+ *    to be moved while a checkpoint is written from it.
+ *
+ * @param pJob       The job.
+ * @param gameAmt    The amount of games played by every job.
+ * @param jobIndex   The number of the job.
+ * @param jobAmt     The amount of jobs.
+ * @param depth      How many plies the players search ahead.
+ * @param seed       The seed of the random choices.
+ *
+ * @return
+ *    1   if the memory of the job was reserved.
+ *    0   otherwise.
+ */
+int initSelfPlayJob(SelfPlayJob *pJob, long gameAmt, int jobIndex, int jobAmt, int depth, uint64_t seed) {
+    pJob->startGame = gameAmt * jobIndex / jobAmt;
+    pJob->endGame = gameAmt * (jobIndex + 1) / jobAmt;
+    pJob->nextGame = pJob->startGame;
+    pJob->depth = depth;
+    pJob->seed = seed;
+    pJob->rules = gRules;
+    pJob->capacity = (pJob->endGame - pJob->startGame) * (2 + MAX_PLY) + 1;
+    pJob->size = 0;
+    pJob->finished = 0;
+    pJob->data = mmap(NULL, pJob->capacity, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (pJob->data == MAP_FAILED) {
+        pJob->data = NULL;
+    }
+    return pJob->data != NULL && initArena(&pJob->scratch, gMemoryBudget / jobAmt);
+}
+ 
+/**
+ * @brief Writes the progress of self-play to its checkpoint file.
+ * @details
+ *    The games each job has finished so far are written straight from the
+ *    job's mapping, while the job keeps playing.
+ *
+ * @param path      The path of the checkpoint.
+ * @param jobs      The jobs.
+ * @param jobAmt    The amount of jobs.
+ * @param gameAmt   The amount of games played by every job.
+ *
+ * @return
+ *    1   if the checkpoint was written.
+ *    0   otherwise.
+ */
+int saveSelfPlayCheckpoint(char path[], SelfPlayJob jobs[], int jobAmt, long gameAmt) {
+    SelfPlayCheckpoint checkpoint = {SELFPLAY_CHECKPOINT_MAGIC, CHECKPOINT_VERSION, jobAmt,
+                                     jobs[0].depth, gameAmt, jobs[0].seed, jobs[0].rules, {0}};
+    const void *parts[MAX_THREAD_AMT + 1] = {&checkpoint};
+    size_t sizes[MAX_THREAD_AMT + 1] = {sizeof(checkpoint)};
+ 
+    for (int i = 0; i < jobAmt; i++) {
+        checkpoint.sizes[i] = __atomic_load_n(&jobs[i].size, __ATOMIC_ACQUIRE);
+        parts[i + 1] = jobs[i].data;
+        sizes[i + 1] = checkpoint.sizes[i];
+    }
+ 
+    return writeFileAtomically(path, parts, sizes, jobAmt + 1);
+}
+ 
+/**
+ * @brief Resumes self-play jobs from a checkpoint of the same games.
+ * @details
+ *    The finished games are copied back into the jobs, which then continue
+ *    from the first game they had not finished. Since each game is seeded by
+ *    its number, the resumed games are the same as if nothing had stopped.
+ *
+ * @param path      The path of the checkpoint.
+ * @param jobs      Array where the jobs are initialized.
+ * @param gameAmt   The amount of games played by every job.
+ * @param depth     How many plies the players search ahead.
+ * @param seed      The seed of the random choices.
+ *
+ * @return
+ *    The amount of jobs   if the checkpoint was loaded.
+ *    0                    if there is no checkpoint of the same games.
+ *    -1                   if the checkpoint could not be loaded.
+ */
+int loadSelfPlayCheckpoint(char path[], SelfPlayJob jobs[], long gameAmt, int depth, uint64_t seed) {
+    SelfPlayCheckpoint checkpoint;
+    FILE *file = fopen(path, "rb");
+    int jobAmt = 0;
+ 
+    if (file != NULL && fread(&checkpoint, sizeof(checkpoint), 1, file) == 1 &&
+        memcmp(checkpoint.magic, SELFPLAY_CHECKPOINT_MAGIC, sizeof(checkpoint.magic)) == 0 &&
+        checkpoint.version == CHECKPOINT_VERSION && checkpoint.gameAmt == gameAmt &&
+        checkpoint.depth == depth && checkpoint.seed == seed && checkpoint.rules.sParity == gRules.sParity &&
+        checkpoint.rules.startRows == gRules.startRows && checkpoint.rules.pieceAmt == gRules.pieceAmt &&
+        checkpoint.jobAmt > 0 && checkpoint.jobAmt <= MAX_THREAD_AMT) {
+        jobAmt = checkpoint.jobAmt;
+    }
+ 
+    for (int i = 0; i < jobAmt; i++) {
+        SelfPlayJob *pJob = &jobs[i];
+        if (initSelfPlayJob(pJob, gameAmt, i, jobAmt, depth, seed) == 0 ||
+            checkpoint.sizes[i] < 0 || checkpoint.sizes[i] > pJob->capacity ||
+            fread(pJob->data, 1, checkpoint.sizes[i], file) != (size_t) checkpoint.sizes[i]) {
+            jobAmt = -1;
+            break;
+        }
+ 
+        // each game starts with its amount of plies
+        pJob->size = checkpoint.sizes[i];
+        for (long offset = 0; offset < pJob->size; offset += 2 + pJob->data[offset]) {
+            pJob->nextGame++;
+        }
+    }
+ 
+    if (file != NULL) {
+        fclose(file);
+    }
+    return jobAmt;
+}
+ 
+/**
+ * @brief Plays games of the computer against itself and saves them.
+ * @details
+ *    The games are split evenly across one thread per processor. Each game
+ *    is seeded by its number, so the same archive is produced regardless of
+ *    the amount of threads. Each thread gets an equal share of gMemoryBudget
+ *    as an arena, which holds the search state of one game at a time.
+ *
+ *    If checkpoints are enabled, the finished games are written to
+ *    <archive>.ckpt every gCheckpointInterval seconds, and a later run with
+ *    the same arguments resumes from it. The checkpoint is removed once the
+ *    archive is written.
+ *
+ * @param gameAmt   The amount of games to be played.
+ * @param path      The path of the archive to be written.
+ * @param depth     How many plies the players search ahead.
+ * @param seed      The seed of the random choices.
+ *
+ * @return
+ *    0   if the archive was written.
+ *    1   otherwise.
+ */
+int runSelfPlay(long gameAmt, char path[], int depth, uint64_t seed) {
+    int threadAmt = getCoreAmt();
+    pthread_t threads[MAX_THREAD_AMT];
+    SelfPlayJob jobs[MAX_THREAD_AMT];
+    if (threadAmt > MAX_THREAD_AMT) {
+        threadAmt = MAX_THREAD_AMT;
+    }
+ 
+    char checkpointPath[CHECKPOINT_PATH_LEN];
+    snprintf(checkpointPath, sizeof(checkpointPath), "%s.ckpt", path);
+    int resumedAmt = 0;
+    if (gCheckpointInterval > 0) {
+        resumedAmt = loadSelfPlayCheckpoint(checkpointPath, jobs, gameAmt, depth, seed);
+    }
+    if (resumedAmt < 0) {
+        printf("ERROR: Could not resume from %s!\n", checkpointPath);
+        return 1;
+    }
+ 
+    long playedAmt = 0;
+    threadAmt = resumedAmt > 0 ? resumedAmt : threadAmt;
+    for (int i = 0; i < threadAmt; i++) {
+        if (resumedAmt == 0 && initSelfPlayJob(&jobs[i], gameAmt, i, threadAmt, depth, seed) == 0) {
+            printf("ERROR: Could not reserve the memory of the games!\n");
+            return 1;
+        }
+        playedAmt += jobs[i].nextGame - jobs[i].startGame;
+    }
+    if (resumedAmt > 0) {
+        printf("Resumed from %s after %ld games.\n", checkpointPath, playedAmt);
+    }
+ 
+    double startTime = getTime();
+    for (int i = 0; i < threadAmt; i++) {
+        pthread_create(&threads[i], NULL, runSelfPlayJob, &jobs[i]);
+    }
+ 
+    // the threads are only waited for once they are done, checkpointing meanwhile
+    double nextCheckpoint = startTime + gCheckpointInterval;
+    int finishedAmt = 0;
+    while (gCheckpointInterval > 0 && finishedAmt < threadAmt) {
+        usleep(CHECKPOINT_POLL_US);
+        finishedAmt = 0;
+        for (int i = 0; i < threadAmt; i++) {
+            finishedAmt += __atomic_load_n(&jobs[i].finished, __ATOMIC_ACQUIRE);
+        }
+ 
+        if (finishedAmt < threadAmt && getTime() >= nextCheckpoint) {
+            if (saveSelfPlayCheckpoint(checkpointPath, jobs, threadAmt, gameAmt) == 0) {
+                printf("ERROR: Could not write %s!\n", checkpointPath);
+            }
+            nextCheckpoint = getTime() + gCheckpointInterval;
+        }
+    }
+ 
+    FILE *file = fopen(path, "wb");
+    if (file != NULL) {
+        unsigned char header[ARCHIVE_HEADER_SIZE];
+        writeArchiveHeader(header, ARCHIVE_MAGIC);
+        fwrite(header, 1, sizeof(header), file);
+    }
+ 
+    long size = 0;
+    Arena scratchTotal = {0};
+    for (int i = 0; i < threadAmt; i++) {
+        pthread_join(threads[i], NULL);
+        if (file != NULL) {
+            fwrite(jobs[i].data, 1, jobs[i].size, file);
+        }
+        size += jobs[i].size;
+        munmap(jobs[i].data, jobs[i].capacity);
+ 
+        // the peak of the total is the largest peak of a single thread
+        scratchTotal.budget += jobs[i].scratch.budget;
+        if (jobs[i].scratch.peak > scratchTotal.peak) {
+            scratchTotal.peak = jobs[i].scratch.peak;
+        }
+        scratchTotal.allocAmt += jobs[i].scratch.allocAmt;
+        scratchTotal.resetAmt += jobs[i].scratch.resetAmt;
+        scratchTotal.failAmt += jobs[i].scratch.failAmt;
+        freeArena(&jobs[i].scratch);
+    }
+    printArenaStats("Scratch memory (peak per thread)", &scratchTotal);
+ 
+    if (file == NULL || fclose(file) != 0) {
+        printf("ERROR: Could not write %s!\n", path);
+        return 1;
+    }
+ 
+    if (scratchTotal.failAmt > 0) {
+        printf("ERROR: The memory budget is too small, so some games were not played!\n");
+        return 1;
+    }
+ 
+    if (gCheckpointInterval > 0) {
+        unlink(checkpointPath);
+    }
+ 
+    double elapsed = getTime() - startTime;
+    printf("%ld games (%ld plies) written to %s in %.2f s using %d threads.\n",
+           gameAmt, size - 2 * gameAmt, path, elapsed, threadAmt);
+    return 0;
+}
+ 
+/**
+ * @brief Adds a labeled position to a training set, growing it if needed.
+ *
+ * @param pSet       The training set.
+ * @param features   The FEATURE_AMT features of the position.
+ * @param label      1 if Alpha won the game, 0 if Beta did, 0.5 if neither.
+ */
+void addTrainingPos(TrainingSet *pSet, int features[], float label) {
+    if (pSet->amt == pSet->capacity) {
+        pSet->capacity = pSet->capacity == 0 ? 65536 : pSet->capacity * 2;
+        for (int k = 0; k < FEATURE_AMT; k++) {
+            pSet->features[k] = realloc(pSet->features[k], pSet->capacity * sizeof(float));
+        }
+        pSet->labels = realloc(pSet->labels, pSet->capacity * sizeof(float));
+    }
+ 
+    for (int k = 0; k < FEATURE_AMT; k++) {
+        pSet->features[k][pSet->amt] = (float) features[k];
+    }
+    pSet->labels[pSet->amt] = label;
+    pSet->amt++;
+}
+ 
+/**
+ * @brief Loads every position of the games in an archive into a training set.
+ * @details
+ *    Each game is replayed from the start, and the features of every
+ *    position in which the game is still ongoing are added along with the
+ *    result of the game as the label. Games that break the rules (see
+ *    validateGame()) are skipped before any of their positions are added.
+ *
+ * @param path   The path of the game archive.
+ * @param pSet   The training set, which must be zero-initialized.
+ *
+ * @return
+ *    0   if the archive was loaded.
+ *    1   otherwise.
+ */
+int loadTrainingSet(char path[], TrainingSet *pSet) {
+    long size = 0;
+    unsigned char *data = openArchive(path, &size);
+    long offset = ARCHIVE_HEADER_SIZE;
+    if (data == NULL) {
+        return 1;
+    }
+ 
+    GameRecord record;
+    long invalidAmt = 0;
+    while (readArchiveGame(data, size, &offset, &record)) {
+        int ply = 0;
+        if (validateGame(&record, &ply) != VERDICT_OK) {
+            invalidAmt++;
+            continue;
+        }
+ 
+        float label = record.result == ALPHA_WIN ? 1.0f : record.result == BETA_WIN ? 0.0f : 0.5f;
+        GameData game;
+        initGameData(&game);
+ 
+        for (int i = 0; i < record.plyAmt; i++) {
+            int features[FEATURE_AMT];
+            computeFeatures(&game, features);
+            addTrainingPos(pSet, features, label);
+ 
+            Move move;
+            decodeMove(&game, record.moves[i], &move);
+            applyMove(&game, move);
+        }
+    }
+ 
+    if (invalidAmt > 0) {
+        printf("ERROR: %ld games break the rules and were skipped (see --validate)!\n", invalidAmt);
+    }
+    closeArchive(data, size);
+    return 0;
+}
+ 
+/**
+ * @brief
+ *    Computes the logistic loss and its gradient over a slice of the
+ *    training set.
+ * @details
+ *    The positions are processed in blocks so that each loop over the block
+ *    runs over contiguous arrays and can be vectorized by the compiler.
+ *
+ * @param arg   Pointer to the TuneJob of the thread.
+ *
+ * @return NULL.
+ */
+void *runTuneJob(void *arg) {
+    TuneJob *pJob = arg;
+    TrainingSet *pSet = pJob->pSet;
+    float scores[TUNE_BLOCK_AMT];
+    double loss = 0;
+    double gradient[FEATURE_AMT] = {0};
+ 
+    for (long start = pJob->startPos; start < pJob->endPos; start += TUNE_BLOCK_AMT) {
+        int amt = pJob->endPos - start < TUNE_BLOCK_AMT ? (int) (pJob->endPos - start) : TUNE_BLOCK_AMT;
+        float *labels = pSet->labels + start;
+ 
+        for (int i = 0; i < amt; i++) {
+            scores[i] = 0;
+        }
+        for (int k = 0; k < FEATURE_AMT; k++) {
+            float *features = pSet->features[k] + start;
+            float weight = pJob->weights[k] / TUNE_SCALE;
+            for (int i = 0; i < amt; i++) {
+                scores[i] += weight * features[i];
+            }
+        }
+ 
+        // scores become the predicted chance of Alpha winning, then the error
+        for (int i = 0; i < amt; i++) {
+            float chance = 1.0f / (1.0f + expf(-scores[i]));
+            chance = chance < 1e-6f ? 1e-6f : chance > 1 - 1e-6f ? 1 - 1e-6f : chance;
+            loss -= labels[i] * logf(chance) + (1 - labels[i]) * logf(1 - chance);
+            scores[i] = chance - labels[i];
+        }
+ 
+        for (int k = 0; k < FEATURE_AMT; k++) {
+            float *features = pSet->features[k] + start;
+            float sum = 0;
+            for (int i = 0; i < amt; i++) {
+                sum += scores[i] * features[i];
+            }
+            gradient[k] += sum;
+        }
+    }
+ 
+    pJob->loss = loss;
+    for (int k = 0; k < FEATURE_AMT; k++) {
+        pJob->gradient[k] = gradient[k] / TUNE_SCALE;
+    }
+    return NULL;
+}
+ 
+/**
+ * @brief Fits the evaluation weights to the results of archived games.
+ * @details
+ *    The weights are fitted by minimizing the logistic loss between the
+ *    evaluation (scaled by TUNE_SCALE) and the result of the game each
+ *    position comes from, using Adam. Each epoch splits the training set
+ *    across the given amount of threads, which compute partial gradients
+ *    that are then summed.
+ *
+ * @param path        The path of the game archive.
+ * @param threadAmt   The amount of threads to use.
+ * @param epochAmt    The amount of passes over the training set.
+ *
+ * @return
+ *    0   if the weights were fitted.
+ *    1   otherwise.
+ */
+int runTuner(char path[], int threadAmt, int epochAmt) {
+    TrainingSet set = {0};
+    double startTime = getTime();
+    if (loadTrainingSet(path, &set) != 0) {
+        return 1;
+    }
+    printf("Loaded %ld positions in %.2f s.\n", set.amt, getTime() - startTime);
+    if (set.amt == 0) {
+        return 1;
+    }
+ 
+    if (threadAmt < 1 || threadAmt > MAX_THREAD_AMT) {
+        threadAmt = threadAmt < 1 ? getCoreAmt() : MAX_THREAD_AMT;
+    }
+ 
+    double weights[FEATURE_AMT] = {gEvalWeights.material, gEvalWeights.advancement,
+                                   gEvalWeights.onStart, gEvalWeights.threatened};
+    double moment1[FEATURE_AMT] = {0};
+    double moment2[FEATURE_AMT] = {0};
+    pthread_t threads[MAX_THREAD_AMT];
+    TuneJob jobs[MAX_THREAD_AMT];
+    double totalTime = 0;
+ 
+    for (int epoch = 1; epoch <= epochAmt; epoch++) {
+        double epochStart = getTime();
+        for (int i = 0; i < threadAmt; i++) {
+            jobs[i].pSet = &set;
+            jobs[i].startPos = set.amt * i / threadAmt;
+            jobs[i].endPos = set.amt * (i + 1) / threadAmt;
+            memcpy(jobs[i].weights, weights, sizeof(weights));
+            pthread_create(&threads[i], NULL, runTuneJob, &jobs[i]);
+        }
+ 
+        double loss = 0;
+        double gradient[FEATURE_AMT] = {0};
+        for (int i = 0; i < threadAmt; i++) {
+            pthread_join(threads[i], NULL);
+            loss += jobs[i].loss;
+            for (int k = 0; k < FEATURE_AMT; k++) {
+                gradient[k] += jobs[i].gradient[k];
+            }
+        }
+ 
+        // Adam update
+        for (int k = 0; k < FEATURE_AMT; k++) {
+            double grad = gradient[k] / set.amt;
+            moment1[k] = 0.9 * moment1[k] + 0.1 * grad;
+            moment2[k] = 0.999 * moment2[k] + 0.001 * grad * grad;
+            double corrected1 = moment1[k] / (1 - pow(0.9, epoch));
+            double corrected2 = moment2[k] / (1 - pow(0.999, epoch));
+            weights[k] -= TUNE_RATE * corrected1 / (sqrt(corrected2) + 1e-8);
+        }
+ 
+        double epochTime = getTime() - epochStart;
+        totalTime += epochTime;
+        if (epoch == 1 || epoch % 10 == 0 || epoch == epochAmt) {
+            printf("epoch %4d  loss %.6f  %8.2f ms  %7.1f M positions/s\n", epoch, loss / set.amt,
+                   epochTime * 1000, set.amt / epochTime / 1e6);
+        }
+    }
+ 
+    printf("\n%d epochs in %.2f s using %d threads (%.2f ms per epoch).\n",
+           epochAmt, totalTime, threadAmt, totalTime * 1000 / epochAmt);
+    printf("EvalWeights gEvalWeights = {%.0f, %.0f, %.0f, %.0f};\n",
+           weights[0], weights[1], weights[2], weights[3]);
+ 
+    for (int k = 0; k < FEATURE_AMT; k++) {
+        free(set.features[k]);
+    }
+    free(set.labels);
+    return 0;
+}
+ 
+/**
+ * @brief Validates chunks of an archive until there are none left.
+ * @details
+ *    Each thread repeatedly claims the next chunk of games that no thread
+ *    has claimed yet, so threads that finish early take over more chunks.
+ *
+ * @param arg   Pointer to the ValidateJob shared by every thread.
+ *
+ * @return NULL.
+ */
+void *runValidateJob(void *arg) {
+    ValidateJob *pJob = arg;
+    gRules = pJob->rules; // the rules are per thread
+    long chunk = 0;
+ 
+    while ((chunk = __atomic_fetch_add(&pJob->nextChunk, 1, __ATOMIC_RELAXED)) < pJob->chunkAmt) {
+        long offset = pJob->chunkOffsets[chunk];
+        long endGame = (chunk + 1) * VALIDATE_CHUNK_AMT;
+        if (endGame > pJob->gameAmt) {
+            endGame = pJob->gameAmt;
+        }
+ 
+        GameRecord record;
+        for (long i = chunk * VALIDATE_CHUNK_AMT; i < endGame; i++) {
+            readArchiveGame(pJob->data, pJob->size, &offset, &record);
+            int ply = 0;
+            pJob->verdicts[i].verdict = (unsigned char) validateGame(&record, &ply);
+            pJob->verdicts[i].ply = (unsigned char) ply;
+        }
+    }
+ 
+    return NULL;
+}
+ 
+/**
+ * @brief Validates every game of an archive using every processor.
+ * @details
+ *    The archive is mapped into memory, and the start of every chunk of
+ *    VALIDATE_CHUNK_AMT games is found by skipping from game to game. The
+ *    chunks are then validated in parallel (see validateGame()). A summary
+ *    is printed, along with the first problems found, and the verdict of
+ *    every game can be written to a file.
+ *
+ * @param path          The path of the archive.
+ * @param verdictPath   The path of the file where the verdict of each game
+ *                      is written, one line per game (NULL to not write it).
+ *
+ * @return
+ *    0   if every game is valid.
+ *    1   otherwise.
+ */
+int runValidator(char path[], char verdictPath[]) {
+    char *verdictNames[] = {"ok", "bad-code", "not-own-piece", "illegal-move",
+                            "own-capture", "not-s-square", "move-after-end", "wrong-result"};
+    ValidateJob job = {0};
+    job.rules = gRules;
+    job.data = openArchive(path, &job.size);
+    if (job.data == NULL) {
+        return 1;
+    }
+ 
+    double startTime = getTime();
+    long capacity = 1024;
+    long offset = ARCHIVE_HEADER_SIZE;
+    GameRecord record;
+    job.chunkOffsets = malloc(capacity * sizeof(long));
+    while (offset < job.size) {
+        if (job.gameAmt % VALIDATE_CHUNK_AMT == 0) {
+            if (job.chunkAmt == capacity) {
+                capacity *= 2;
+                job.chunkOffsets = realloc(job.chunkOffsets, capacity * sizeof(long));
+            }
+            job.chunkOffsets[job.chunkAmt++] = offset;
+        }
+ 
+        if (readArchiveGame(job.data, job.size, &offset, &record) == 0) {
+            break;
+        }
+        job.gameAmt++;
+    }
+    int truncated = offset < job.size;
+    if (job.gameAmt % VALIDATE_CHUNK_AMT == 0 && truncated) {
+        job.chunkAmt--; // the truncated game started a chunk of its own
+    }
+ 
+    int threadAmt = getCoreAmt() < MAX_THREAD_AMT ? getCoreAmt() : MAX_THREAD_AMT;
+    pthread_t threads[MAX_THREAD_AMT];
+    job.verdicts = malloc((job.gameAmt > 0 ? job.gameAmt : 1) * sizeof(GameVerdict));
+    for (int i = 0; i < threadAmt; i++) {
+        pthread_create(&threads[i], NULL, runValidateJob, &job);
+    }
+    for (int i = 0; i < threadAmt; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    double elapsed = getTime() - startTime;
+ 
+    long verdictAmts[VERDICT_AMT] = {0};
+    for (long i = 0; i < job.gameAmt; i++) {
+        if (job.verdicts[i].verdict != VERDICT_OK && verdictAmts[job.verdicts[i].verdict] == 0) {
+            printf("Game %ld: %s at ply %d\n", i, verdictNames[job.verdicts[i].verdict], job.verdicts[i].ply);
+        }
+        verdictAmts[job.verdicts[i].verdict]++;
+    }
+ 
+    if (verdictPath != NULL) {
+        FILE *file = fopen(verdictPath, "w");
+        for (long i = 0; file != NULL && i < job.gameAmt; i++) {
+            fprintf(file, "%ld %s %d\n", i, verdictNames[job.verdicts[i].verdict], job.verdicts[i].ply);
+        }
+        if (file == NULL || fclose(file) != 0) {
+            printf("ERROR: Could not write %s!\n", verdictPath);
+        }
+    }
+ 
+    printf("%ld games validated in %.3f s using %d threads (%.2f M games/s).\n",
+           job.gameAmt, elapsed, threadAmt, job.gameAmt / elapsed / 1e6);
+    for (int i = 0; i < VERDICT_AMT; i++) {
+        printf("  %-15s %ld\n", verdictNames[i], verdictAmts[i]);
+    }
+    if (truncated) {
+        printf("ERROR: The last game of the archive is cut off!\n");
+    }
+ 
+    free(job.verdicts);
+    free(job.chunkOffsets);
+    closeArchive(job.data, job.size);
+    return verdictAmts[VERDICT_OK] == job.gameAmt && !truncated ? 0 : 1;
+}
+ 
+/**
+ * @brief Compresses a game archive with a range coder.
+ * @details
+ *    The games are compressed in blocks of COMPRESS_BLOCK_AMT games that
+ *    each start with a fresh model, so that they can be decompressed in
+ *    parallel. Each block is stored after a header of three 32-bit numbers:
+ *    its amount of games, its size in archive format and its compressed
+ *    size. Since moves are stored by their index among the legal moves,
+ *    every game must be valid, which is checked with validateGame() first.
+ *
+ * @param path      The path of the archive.
+ * @param outPath   The path of the compressed archive to be written.
+ *
+ * @return
+ *    0   if the compressed archive was written.
+ *    1   otherwise.
+ */
+int runCompressor(char path[], char outPath[]) {
+    long size = 0;
+    unsigned char *data = openArchive(path, &size);
+    if (data == NULL) {
+        return 1;
+    }
+ 
+    double startTime = getTime();
+    long offset = ARCHIVE_HEADER_SIZE;
+    long gameAmt = 0;
+    long plyAmt = 0;
+    GameRecord record;
+    while (readArchiveGame(data, size, &offset, &record)) {
+        int ply = 0;
+        if (validateGame(&record, &ply) != VERDICT_OK) {
+            printf("ERROR: Game %ld is not valid (see --validate), so it cannot be compressed!\n", gameAmt);
+            closeArchive(data, size);
+            return 1;
+        }
+        gameAmt++;
+        plyAmt += record.plyAmt;
+    }
+    if (offset < size) {
+        printf("ERROR: The last game of the archive is cut off!\n");
+        closeArchive(data, size);
+        return 1;
+    }
+ 
+    FILE *file = fopen(outPath, "wb");
+    if (file != NULL) {
+        unsigned char header[ARCHIVE_HEADER_SIZE];
+        writeArchiveHeader(header, COMPRESSED_ARCHIVE_MAGIC);
+        fwrite(header, 1, sizeof(header), file);
+    }
+ 
+    unsigned char *out = malloc(COMPRESS_BLOCK_AMT * MAX_PLY * 2 + 8);
+    long outSize = ARCHIVE_HEADER_SIZE;
+    offset = ARCHIVE_HEADER_SIZE;
+    for (long i = 0; file != NULL && i < gameAmt; i += COMPRESS_BLOCK_AMT) {
+        long blockStart = offset;
+        long blockAmt = gameAmt - i < COMPRESS_BLOCK_AMT ? gameAmt - i : COMPRESS_BLOCK_AMT;
+        uint32_t header[3] = {(uint32_t) blockAmt, 0, 0};
+        header[2] = (uint32_t) compressArchiveBlock(data, size, &offset, blockAmt, out);
+        header[1] = (uint32_t) (offset - blockStart);
+ 
+        fwrite(header, sizeof(header), 1, file);
+        fwrite(out, 1, header[2], file);
+        outSize += sizeof(header) + header[2];
+    }
+    free(out);
+    closeArchive(data, size);
+ 
+    if (file == NULL || fclose(file) != 0) {
+        printf("ERROR: Could not write %s!\n", outPath);
+        return 1;
+    }
+ 
+    double elapsed = getTime() - startTime;
+    printf("%ld games (%ld plies) compressed from %ld to %ld bytes in %.2f s (%.3f bits per move).\n",
+           gameAmt, plyAmt, size, outSize, elapsed, plyAmt > 0 ? outSize * 8.0 / plyAmt : 0.0);
+    return 0;
+}
+ 
+/**
+ * @brief Decompresses an archive compressed by runCompressor().
+ *
+ * @param path      The path of the compressed archive.
+ * @param outPath   The path of the archive to be written.
+ *
+ * @return
+ *    0   if the archive was written.
+ *    1   otherwise.
+ */
+int runDecompressor(char path[], char outPath[]) {
+    long size = 0;
+    double startTime = getTime();
+    unsigned char *data = openArchive(path, &size);
+    if (data == NULL) {
+        return 1;
+    }
+    double elapsed = getTime() - startTime;
+ 
+    FILE *file = fopen(outPath, "wb");
+    if (file != NULL) {
+        fwrite(data, 1, size, file);
+    }
+    closeArchive(data, size);
+ 
+    if (file == NULL || fclose(file) != 0) {
+        printf("ERROR: Could not write %s!\n", outPath);
+        return 1;
+    }
+ 
+    printf("%ld bytes decompressed to %s in %.3f s.\n", size, outPath, elapsed);
+    return 0;
+}
+ 
+/**
+ * @brief Adds an archived game to the statistics of a thread.
+ * @details
+ *    The game is replayed to find its captures and how it ended. A game
+ *    that breaks the rules (see validateGame()) is only counted as damaged,
+ *    so the replay never has to deal with illegal moves.
+ *
+ * @param pStats    The statistics of the thread.
+ * @param pRecord   The archived game.
+ */
+void addGameStats(ArchiveStats *pStats, GameRecord *pRecord) {
+    long captures[ROW_INIT][COL_INIT] = {{0}};
+    int ply = 0;
+    if (validateGame(pRecord, &ply) != VERDICT_OK) {
+        pStats->damagedAmt++;
+        return;
+    }
+ 
+    GameData game;
+    initGameData(&game);
+    for (int i = 0; i < pRecord->plyAmt; i++) {
+        Move move;
+        decodeMove(&game, pRecord->moves[i], &move);
+        captures[move.dest.row][move.dest.col] += move.type == 2;
+        applyMove(&game, move);
+    }
+ 
+    // a win by capturing leaves the loser without pieces
+    int winCondition = WIN_BY_NONE;
+    if (pRecord->result != GAME_ONGOING) {
+        int loserPosAmt = pRecord->result == ALPHA_WIN ? game.betaPosAmt : game.alphaPosAmt;
+        winCondition = loserPosAmt == 0 ? WIN_BY_CAPTURE : WIN_BY_REACH;
+    }
+ 
+    pStats->gameAmt++;
+    pStats->plyAmt += pRecord->plyAmt;
+    pStats->lengths[pRecord->plyAmt < MAX_PLY ? pRecord->plyAmt : MAX_PLY]++;
+    pStats->endings[pRecord->result][winCondition]++;
+    for (int i = 1; i <= ROW; i++) {
+        for (int j = 1; j <= COL; j++) {
+            pStats->captures[i][j] += captures[i][j];
+        }
+    }
+}
+ 
+/**
+ * @brief Claims the next chunk of games of an archive for a thread.
+ * @details
+ *    Game boundaries are only known by walking the archive, so the walk is
+ *    done under a lock, one chunk of STATS_CHUNK_AMT games (or one block of
+ *    a compressed archive) at a time. A compressed block is decompressed
+ *    after the lock is released.
+ *
+ * @param pJob      The archive being scanned.
+ * @param buffer    Array where a compressed block is decompressed, which can
+ *                  hold COMPRESS_BLOCK_AMT * (MAX_PLY + 2) bytes.
+ * @param pChunk    Pointer to where the games of the chunk are stored (in
+ *                  archive format, without ARCHIVE_MAGIC).
+ *
+ * @return The size of the chunk in bytes, 0 if the archive is done, or -1
+ *         if the archive is damaged.
+ */
+long claimStatsChunk(StatsJob *pJob, unsigned char buffer[], unsigned char **pChunk) {
+    ArchiveBlock block = {0, 0, 0, 0, 0};
+    long start = 0;
+    long size = 0;
+ 
+    pthread_mutex_lock(&pJob->lock);
+    start = pJob->offset;
+    if (pJob->compressed && pJob->offset < pJob->size) {
+        size = readArchiveBlock(pJob->data, pJob->size, &pJob->offset, &block) ? block.outSize : -1;
+    } else if (pJob->offset < pJob->size) {
+        GameRecord record;
+        for (int i = 0; i < STATS_CHUNK_AMT && readArchiveGame(pJob->data, pJob->size, &pJob->offset, &record); i++) {
+        }
+        size = pJob->offset > start ? pJob->offset - start : -1;
+    }
+    if (size < 0) {
+        pJob->offset = pJob->size; // the rest of the archive is skipped
+    }
+    pthread_mutex_unlock(&pJob->lock);
+ 
+    *pChunk = pJob->data + start;
+    if (pJob->compressed && size > 0) {
+        long outSize = decompressArchiveBlock(pJob->data + block.offset, block.size, block.gameAmt,
+                                              buffer, block.outSize);
+        size = outSize == block.outSize ? outSize : -1;
+        *pChunk = buffer;
+    }
+ 
+    return size;
+}
+ 
+/**
+ * @brief Adds the games of the chunks claimed by a thread to its statistics.
+ * @details
+ *    Each thread keeps its own statistics, which are only added to the
+ *    total once it is done, so that threads never write to shared memory
+ *    while scanning.
+ *
+ * @param arg   Pointer to the StatsJob shared by every thread.
+ *
+ * @return NULL.
+ */
+void *runStatsJob(void *arg) {
+    StatsJob *pJob = arg;
+    gRules = pJob->rules; // the rules are per thread
+    ArchiveStats *pStats = calloc(1, sizeof(*pStats));
+    unsigned char *buffer = malloc(COMPRESS_BLOCK_AMT * (MAX_PLY + 2));
+    unsigned char *chunk = NULL;
+    long size = 0;
+ 
+    while ((size = claimStatsChunk(pJob, buffer, &chunk)) > 0) {
+        GameRecord record;
+        long offset = 0;
+        while (readArchiveGame(chunk, size, &offset, &record)) {
+            addGameStats(pStats, &record);
+        }
+    }
+ 
+    pthread_mutex_lock(&pJob->lock);
+    pJob->damaged |= size < 0;
+    ArchiveStats *pTotal = &pJob->total;
+    pTotal->gameAmt += pStats->gameAmt;
+    pTotal->plyAmt += pStats->plyAmt;
+    pTotal->damagedAmt += pStats->damagedAmt;
+    for (int i = 0; i <= MAX_PLY; i++) {
+        pTotal->lengths[i] += pStats->lengths[i];
+    }
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < WIN_CONDITION_AMT; j++) {
+            pTotal->endings[i][j] += pStats->endings[i][j];
+        }
+    }
+    for (int i = 1; i <= ROW; i++) {
+        for (int j = 1; j <= COL; j++) {
+            pTotal->captures[i][j] += pStats->captures[i][j];
+        }
+    }
+    pthread_mutex_unlock(&pJob->lock);
+ 
+    free(buffer);
+    free(pStats);
+    return NULL;
+}
+ 
+/**
+ * @brief Prints the statistics of the scanned archives.
+ *
+ * @param pStats   The statistics.
+ */
+void printArchiveStats(ArchiveStats *pStats) {
+    char *resultNames[] = {"No winner", "Alpha wins", "Beta wins"};
+    double gameAmt = pStats->gameAmt > 0 ? pStats->gameAmt : 1;
+ 
+    printf("\nResult        Games       Share   Reached  Captured\n");
+    for (int i = 0; i < 3; i++) {
+        long amt = pStats->endings[i][WIN_BY_REACH] + pStats->endings[i][WIN_BY_CAPTURE] +
+                   pStats->endings[i][WIN_BY_NONE];
+        printf("%-12s %10ld %10.2f%%", resultNames[i], amt, amt * 100.0 / gameAmt);
+        if (i != GAME_ONGOING) {
+            printf(" %9ld %9ld", pStats->endings[i][WIN_BY_REACH], pStats->endings[i][WIN_BY_CAPTURE]);
+        }
+        printf("\n");
+    }
+ 
+    printf("\nLength      Games       Share\n");
+    for (int i = 0; i <= MAX_PLY; i++) {
+        if (pStats->lengths[i] > 0) {
+            printf("%3d%s %12ld %10.2f%%\n", i, i == MAX_PLY ? "+" : " ",
+                   pStats->lengths[i], pStats->lengths[i] * 100.0 / gameAmt);
+        }
+    }
+ 
+    // S squares are marked with an asterisk
+    long sCaptureAmt = 0;
+    long otherCaptureAmt = 0;
+    printf("\nCaptures by square (* marks S squares)\n  ");
+    for (int j = 1; j <= COL; j++) {
+        printf("%10c", 'A' + j - 1);
+    }
+    printf("\n");
+    for (int i = 1; i <= ROW; i++) {
+        printf("%d ", i);
+        for (int j = 1; j <= COL; j++) {
+            Pos square = {i, j};
+            printf("%9ld%c", pStats->captures[i][j], isSquareS(square) ? '*' : ' ');
+            if (isSquareS(square)) {
+                sCaptureAmt += pStats->captures[i][j];
+            } else {
+                otherCaptureAmt += pStats->captures[i][j];
+            }
+        }
+        printf("\n");
+    }
+    printf("Captures on S squares: %ld, on other squares: %ld (%.3f per game)\n",
+           sCaptureAmt, otherCaptureAmt, (sCaptureAmt + otherCaptureAmt) / gameAmt);
+}
+ 
+/**
+ * @brief Scans game archives on every core and prints their statistics.
+ * @details
+ *    Each archive is mapped and scanned in chunks claimed by the threads,
+ *    so memory use does not depend on the size of the archives. Compressed
+ *    archives are decompressed one block at a time by each thread.
+ *
+ * @param paths     The paths of the archives.
+ * @param pathAmt   The amount of archives.
+ *
+ * @return
+ *    0   if every archive was scanned.
+ *    1   otherwise.
+ */
+int runStats(char *paths[], int pathAmt) {
+    int threadAmt = getCoreAmt() < MAX_THREAD_AMT ? getCoreAmt() : MAX_THREAD_AMT;
+    pthread_t threads[MAX_THREAD_AMT];
+    StatsJob *pJob = calloc(1, sizeof(*pJob));
+    int failed = 0;
+    pJob->rules = gRules;
+    pthread_mutex_init(&pJob->lock, NULL);
+ 
+    double startTime = getTime();
+    for (int i = 0; i < pathAmt; i++) {
+        pJob->data = mapArchiveFile(paths[i], &pJob->size);
+        if (pJob->data == NULL) {
+            failed = 1;
+            continue;
+        }
+ 
+        pJob->compressed = memcmp(pJob->data, COMPRESSED_ARCHIVE_MAGIC, strlen(COMPRESSED_ARCHIVE_MAGIC)) == 0;
+        pJob->offset = ARCHIVE_HEADER_SIZE;
+        pJob->damaged = 0;
+        for (int j = 0; j < threadAmt; j++) {
+            pthread_create(&threads[j], NULL, runStatsJob, pJob);
+        }
+        for (int j = 0; j < threadAmt; j++) {
+            pthread_join(threads[j], NULL);
+        }
+ 
+        if (pJob->damaged) {
+            printf("ERROR: %s is damaged or cut off, so only part of it was scanned!\n", paths[i]);
+            failed = 1;
+        }
+        closeArchive(pJob->data, pJob->size);
+    }
+    double elapsed = getTime() - startTime;
+ 
+    ArchiveStats *pStats = &pJob->total;
+    printf("%ld games (%ld plies, %.2f per game) scanned in %.3f s using %d threads (%.2f M games/s).\n",
+           pStats->gameAmt, pStats->plyAmt, pStats->plyAmt / (pStats->gameAmt > 0 ? (double) pStats->gameAmt : 1.0),
+           elapsed, threadAmt, pStats->gameAmt / elapsed / 1e6);
+    if (pStats->damagedAmt > 0) {
+        printf("ERROR: %ld games break the rules and were skipped (see --validate)!\n", pStats->damagedAmt);
+        failed = 1;
+    }
+    printArchiveStats(pStats);
+ 
+    pthread_mutex_destroy(&pJob->lock);
+    free(pJob);
+    return failed;
+}
+ 
+/**
+ * @brief Parses rules written as <S squares>:<start rows>:<pieces>.
+ * @details
+ *    S squares are "same" (rows and columns of the same parity, the
+ *    default) or "opposite". For example, "same:2:5" are the default rules.
+ *    The starting positions of both players may not overlap or touch, and
+ *    there can be at most MAX_POS_AMT pieces.
+ *
+ * @param text     The rules.
+ * @param pRules   Pointer to where the rules are stored.
+ *
+ * @return
+ *    1   if the rules are valid.
+ *    0   otherwise.
+ */
+int parseRules(char text[], Rules *pRules) {
+    char parity[16];
+    Rules rules;
+    int isValid = sscanf(text, "%15[a-z]:%d:%d", parity, &rules.startRows, &rules.pieceAmt) == 3;
+ 
+    rules.sParity = strcmp(parity, "opposite") == 0;
+    if (isValid && (rules.sParity || strcmp(parity, "same") == 0) &&
+        rules.startRows >= 1 && 2 * rules.startRows < ROW &&
+        rules.pieceAmt >= 1 && rules.pieceAmt <= MAX_POS_AMT) {
+        *pRules = rules;
+    } else {
+        isValid = 0;
+    }
+ 
+    return isValid;
+}
+ 
+/**
+ * @brief Writes rules in the format read by parseRules().
+ *
+ * @param rules    The rules.
+ * @param buffer   Array where the text is stored, which can hold 32 chars.
+ */
+void formatRules(Rules rules, char buffer[]) {
+    snprintf(buffer, 32, "%s:%d:%d", rules.sParity ? "opposite" : "same", rules.startRows, rules.pieceAmt);
+}
+ 
+/**
+ * @brief Estimates how long a variant of the rules takes to sweep.
+ * @details
+ *    Games last about as long as it takes every piece to cross the board,
+ *    and a search at depth d visits roughly b^(d/2) positions with good
+ *    move ordering, where b is the amount of moves at the start. Only how
+ *    the estimates compare matters, since they are used to start the most
+ *    costly variants first.
+ *
+ * @param pGame     The starting position of the variant, whose rules are
+ *                  in gRules.
+ * @param gameAmt   The amount of games played per variant.
+ * @param depth     How many plies the players search ahead.
+ *
+ * @return The estimated cost.
+ */
+double estimateVariantCost(GameData *pGame, long gameAmt, int depth) {
+    Move moves[MAX_MOVE_AMT];
+    int moveAmt = generateMoves(pGame, moves);
+    double plyAmt = 2.0 * pGame->alphaPosAmt * (ROW - gRules.startRows);
+    return gameAmt * plyAmt * pow(moveAmt > 1 ? moveAmt : 2, depth / 2.0) + SWEEP_SOLVE_NODE_AMT;
+}
+ 
+/**
+ * @brief Plays the self-play games and runs the solver of the claimed variants.
+ * @details
+ *    The rules of the thread are switched to each variant in turn. Games are
+ *    seeded by their number as in runSelfPlay(), so the results do not
+ *    depend on which thread plays a variant.
+ *
+ * @param arg   Pointer to the SweepJob shared by every thread.
+ *
+ * @return NULL.
+ */
+void *runSweepJob(void *arg) {
+    SweepJob *pJob = arg;
+    SearchInfo *pInfo = malloc(sizeof(*pInfo));
+    Solver solver;
+    int index = 0;
+    if (pInfo == NULL) {
+        __atomic_store_n(&pJob->failed, 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+ 
+    while ((index = __atomic_fetch_add(&pJob->nextVariant, 1, __ATOMIC_RELAXED)) < pJob->variantAmt) {
+        SweepVariant *pVariant = pJob->order[index];
+        double startTime = getTime();
+        gRules = pVariant->rules;
+ 
+        for (long i = 0; i < pJob->gameAmt; i++) {
+            unsigned char codes[MAX_PLY];
+            int result = GAME_ONGOING;
+            pInfo->useOrdering = 1;
+            pInfo->pTable = NULL; // as in self-play, so that sweeps can be reproduced
+            pVariant->plyAmt += playSelfPlayGame(mixSeed(pJob->seed ^ (uint64_t) i), pJob->depth, pInfo,
+                                                 codes, &result);
+            pVariant->results[result]++;
+        }
+ 
+        // the first player is Alpha
+        pVariant->solved = PN_UNKNOWN;
+        if (initSolver(&solver, pJob->solverBudget)) {
+            GameData game;
+            Move move;
+            initGameData(&game);
+            solver.maxNodes = SWEEP_SOLVE_NODE_AMT;
+            pVariant->solved = solvePosition(&solver, &game, &move);
+            freeSolver(&solver);
+        }
+        pVariant->elapsed = getTime() - startTime;
+    }
+ 
+    free(pInfo);
+    return NULL;
+}
+ 
+/**
+ * @brief Compares two variants by estimated cost, most costly first, for qsort().
+ *
+ * @return
+ *    -1   if the first variant is more costly than the second.
+ *    1    if the first variant is less costly than the second.
+ *    0    if both cost the same.
+ */
+int compareVariantCost(const void *variant1, const void *variant2) {
+    double cost1 = (*(SweepVariant * const *) variant1)->cost;
+    double cost2 = (*(SweepVariant * const *) variant2)->cost;
+    return (cost1 < cost2) - (cost1 > cost2);
+}
+ 
+/**
+ * @brief Compares variants of the rules on every core and prints a table.
+ * @details
+ *    Every combination of S squares, starting rows and amount of pieces
+ *    that fits the board is a variant, except those with more pieces than
+ *    starting positions and those that start the same as an earlier variant
+ *    (since pieces fill the starting positions from the back, extra starting
+ *    rows often go unused). Each variant plays gameAmt self-play games and
+ *    tries to solve the starting position within SWEEP_SOLVE_NODE_AMT
+ *    nodes. Variants are claimed by the threads from the most to the least
+ *    costly estimate, so that no thread is left with a long variant at the
+ *    end. The board size is fixed when compiling (see ROW and COL), so
+ *    other sizes are swept by builds of their own.
+ *
+ * @param gameAmt   The amount of games played per variant.
+ * @param depth     How many plies the players search ahead.
+ * @param seed      The seed of the random choices.
+ *
+ * @return 0.
+ */
+int runSweep(long gameAmt, int depth, uint64_t seed) {
+    char *solvedNames[] = {"unknown", "win", "loss", "draw"};
+    int threadAmt = getCoreAmt() < MAX_THREAD_AMT ? getCoreAmt() : MAX_THREAD_AMT;
+    pthread_t threads[MAX_THREAD_AMT];
+    SweepVariant variants[SWEEP_MAX_VARIANT_AMT];
+    SweepVariant *order[SWEEP_MAX_VARIANT_AMT];
+    PackedPos starts[SWEEP_MAX_VARIANT_AMT];
+    Rules defaultRules = gRules;
+    int variantAmt = 0;
+ 
+    for (int sParity = 0; sParity <= 1; sParity++) {
+        for (int startRows = 1; 2 * startRows < ROW; startRows++) {
+            for (int pieceAmt = 2; pieceAmt <= MAX_POS_AMT && variantAmt < SWEEP_MAX_VARIANT_AMT; pieceAmt++) {
+                SweepVariant variant = {{sParity, startRows, pieceAmt}, 0, {0}, 0, PN_UNKNOWN, 0};
+                GameData game;
+                gRules = variant.rules;
+                initGameData(&game);
+                int isNew = game.alphaPosAmt == pieceAmt && game.betaPosAmt == pieceAmt;
+                for (int i = 0; i < variantAmt && isNew; i++) {
+                    isNew = comparePackedPos(starts[i], packPos(&game)) != 0;
+                }
+ 
+                if (isNew) {
+                    starts[variantAmt] = packPos(&game);
+                    variant.cost = estimateVariantCost(&game, gameAmt, depth);
+                    variants[variantAmt] = variant;
+                    order[variantAmt] = &variants[variantAmt];
+                    variantAmt++;
+                }
+            }
+        }
+    }
+    gRules = defaultRules;
+    qsort(order, variantAmt, sizeof(SweepVariant *), compareVariantCost);
+ 
+    SweepJob job = {variants, order, variantAmt, 0, gameAmt, depth, seed, gMemoryBudget / threadAmt, 0};
+    double startTime = getTime();
+    for (int i = 0; i < threadAmt; i++) {
+        pthread_create(&threads[i], NULL, runSweepJob, &job);
+    }
+    for (int i = 0; i < threadAmt; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    double elapsed = getTime() - startTime;
+    if (job.failed) {
+        printf("ERROR: Could not reserve the search state of every thread!\n");
+        return 1;
+    }
+ 
+    printf("%d variants of %ld games (depth %d) on a %dx%d board in %.2f s using %d threads.\n\n",
+           variantAmt, gameAmt, depth, ROW, COL, elapsed, threadAmt);
+    printf("Rules            Alpha%%   Beta%%   None%%  Advantage   Plies  Solved      Time\n");
+    for (int i = 0; i < variantAmt; i++) {
+        char rulesText[32];
+        double games = gameAmt > 0 ? gameAmt : 1;
+        double alphaPct = variants[i].results[ALPHA_WIN] * 100.0 / games;
+        double betaPct = variants[i].results[BETA_WIN] * 100.0 / games;
+        formatRules(variants[i].rules, rulesText);
+        printf("%-14s %7.1f %7.1f %7.1f %+10.1f %7.1f  %-8s %7.2f\n", rulesText, alphaPct, betaPct,
+               variants[i].results[GAME_ONGOING] * 100.0 / games, alphaPct - betaPct,
+               variants[i].plyAmt / games, solvedNames[variants[i].solved], variants[i].elapsed);
+    }
+    printf("\nAdvantage is the first player's (Alpha's) win rate minus Beta's, in points.\n");
+    printf("Solved is the result for Alpha with perfect play, if found within %d nodes.\n",
+           SWEEP_SOLVE_NODE_AMT);
+ 
+    return 0;
+}
+ 
+/**
+ * @brief Compares two annotated positions by hash, for qsort().
+ *
+ * @return
+ *    -1   if the first position is ordered before the second.
+ *    1    if the first position is ordered after the second.
+ *    0    if both are the same position.
+ */
+int compareAnnotatePos(const void *pos1, const void *pos2) {
+    const AnnotatePos *pPos1 = pos1;
+    const AnnotatePos *pPos2 = pos2;
+ 
+    if (pPos1->hash != pPos2->hash) {
+        return pPos1->hash < pPos2->hash ? -1 : 1;
+    }
+    return comparePackedPos(pPos1->packed, pPos2->packed);
+}
+ 
+/**
+ * @brief Analyzes unique positions until there are none left.
+ * @details
+ *    Each thread repeatedly claims the next position that no thread has
+ *    claimed yet and searches it with its own search state, while sharing
+ *    the transposition table with every other thread. Positions where the
+ *    game is over or the current player has no moves are scored without a
+ *    search.
+ *
+ * @param arg   Pointer to the AnnotateJob shared by every thread.
+ *
+ * @return NULL.
+ */
+void *runAnnotateJob(void *arg) {
+    AnnotateJob *pJob = arg;
+    gRules = pJob->rules; // the rules are per thread
+    SearchInfo *pInfo = malloc(sizeof(*pInfo));
+    if (pInfo == NULL) {
+        __atomic_store_n(&pJob->failed, 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+    GameData game;
+    initGameData(&game);
+    pInfo->useOrdering = 1;
+    pInfo->pTable = pJob->pTable;
+    long index = 0;
+ 
+    while ((index = __atomic_fetch_add(&pJob->nextPos, 1, __ATOMIC_RELAXED)) < pJob->uniqueAmt) {
+        unpackPos(pJob->unique[index], &game);
+        Move moves[MAX_MOVE_AMT];
+        int over = checkGameStatus(&game);
+ 
+        pJob->bestCodes[index] = -1;
+        if (over != GAME_ONGOING) {
+            pJob->scores[index] = over == game.curPlayer ? WIN_SCORE : -WIN_SCORE;
+        } else if (generateMoves(&game, moves) == 0) {
+            pJob->scores[index] = 0;
+        } else {
+            Move bestMove;
+            searchBestMove(&game, pJob->depth, pInfo, &bestMove);
+            pJob->bestCodes[index] = encodeMove(bestMove);
+            pJob->scores[index] = pInfo->bestScore;
+        }
+ 
+        // scores are stored from Alpha's point of view
+        if (game.curPlayer == 2) {
+            pJob->scores[index] = -pJob->scores[index];
+        }
+        __atomic_fetch_add(&pJob->nodes, pInfo->nodes, __ATOMIC_RELAXED);
+        pInfo->nodes = 0;
+    }
+ 
+    free(pInfo);
+    return NULL;
+}
+ 
+/**
+ * @brief Marks a move by how much worse it is than the best move.
+ *
+ * @param loss   How many points the move loses compared to the best move,
+ *               from the point of view of the player who made it.
+ *
+ * @return "best", "inaccuracy" or "blunder".
+ */
+char *getMoveMark(int loss) {
+    if (loss <= ANNOTATE_BEST_MARGIN) {
+        return "best";
+    } else if (loss < ANNOTATE_BLUNDER_LOSS) {
+        return "inaccuracy";
+    } else {
+        return "blunder";
+    }
+}
+ 
+/**
+ * @brief Analyzes every position of every game in an archive.
+ * @details
+ *    Every game must be valid, which is checked with validateGame() first.
+ *    Every position of every game (including the final one) is packed and
+ *    sorted by hash, so that positions that occur in many games or through
+ *    different move orders are only analyzed once. The unique positions are
+ *    then searched in parallel with a shared transposition table that takes
+ *    up the memory budget (see runAnnotateJob()).
+ *
+ *    Each game is written as a line of JSON that has, for every ply, the
+ *    move played, the best move, the evaluation before the move and after
+ *    the move (both from Alpha's point of view), and a mark that compares
+ *    the two (see getMoveMark()).
+ *
+ * @param path      The path of the archive.
+ * @param outPath   The path of the file where the annotated games are written.
+ * @param depth     How many plies each position is searched.
+ *
+ * @return
+ *    0   if the games were annotated.
+ *    1   otherwise.
+ */
+int runAnnotator(char path[], char outPath[], int depth) {
+    long size = 0;
+    unsigned char *data = openArchive(path, &size);
+    if (data == NULL) {
+        return 1;
+    }
+ 
+    // count the positions, then pack every one of them
+    double startTime = getTime();
+    long offset = ARCHIVE_HEADER_SIZE;
+    long posAmt = 0;
+    long gameAmt = 0;
+    GameRecord record;
+    while (readArchiveGame(data, size, &offset, &record)) {
+        int ply = 0;
+        if (validateGame(&record, &ply) != VERDICT_OK) {
+            printf("ERROR: Game %ld is not valid (see --validate), so it cannot be annotated!\n", gameAmt);
+            closeArchive(data, size);
+            return 1;
+        }
+        posAmt += record.plyAmt + 1;
+        gameAmt++;
+    }
+ 
+    AnnotatePos *positions = malloc((posAmt > 0 ? posAmt : 1) * sizeof(AnnotatePos));
+    long *uniqueIndexes = malloc((posAmt > 0 ? posAmt : 1) * sizeof(long));
+    GameData game;
+    long posIndex = 0;
+    offset = ARCHIVE_HEADER_SIZE;
+    while (readArchiveGame(data, size, &offset, &record)) {
+        initGameData(&game);
+        for (int i = 0; i <= record.plyAmt; i++) {
+            positions[posIndex].packed = packPos(&game);
+            positions[posIndex].hash = hashPackedPos(positions[posIndex].packed);
+            positions[posIndex].index = posIndex;
+            posIndex++;
+ 
+            Move move;
+            if (i < record.plyAmt) {
+                decodeMove(&game, record.moves[i], &move);
+                applyMove(&game, move);
+            }
+        }
+    }
+ 
+    qsort(positions, posAmt, sizeof(AnnotatePos), compareAnnotatePos);
+    AnnotateJob job = {0};
+    job.rules = gRules;
+    job.depth = depth;
+    job.unique = malloc((posAmt > 0 ? posAmt : 1) * sizeof(PackedPos));
+    for (long i = 0; i < posAmt; i++) {
+        if (i == 0 || positions[i].packed != positions[i - 1].packed) {
+            job.unique[job.uniqueAmt++] = positions[i].packed;
+        }
+        uniqueIndexes[positions[i].index] = job.uniqueAmt - 1;
+    }
+    free(positions);
+    printf("%ld positions (%ld unique) collected in %.2f s.\n", posAmt, job.uniqueAmt, getTime() - startTime);
+ 
+    // analyze every unique position
+    TransTable table = {NULL, 0, NULL, 0};
+    if (gSharedTable == NULL && initTransTable(&table, gMemoryBudget) == 0) {
+        printf("ERROR: Could not reserve the transposition table!\n");
+        return 1;
+    }
+    job.pTable = gSharedTable != NULL ? gSharedTable : &table;
+    job.bestCodes = malloc((job.uniqueAmt > 0 ? job.uniqueAmt : 1) * sizeof(int));
+    job.scores = malloc((job.uniqueAmt > 0 ? job.uniqueAmt : 1) * sizeof(int));
+ 
+    startTime = getTime();
+    int threadAmt = getCoreAmt() < MAX_THREAD_AMT ? getCoreAmt() : MAX_THREAD_AMT;
+    pthread_t threads[MAX_THREAD_AMT];
+    for (int i = 0; i < threadAmt; i++) {
+        pthread_create(&threads[i], NULL, runAnnotateJob, &job);
+    }
+    for (int i = 0; i < threadAmt; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    double elapsed = getTime() - startTime;
+    if (job.failed) {
+        printf("ERROR: Could not reserve the search state of every thread!\n");
+        freeTransTable(&table);
+        free(job.unique);
+        free(job.bestCodes);
+        free(job.scores);
+        free(uniqueIndexes);
+        closeArchive(data, size);
+        return 1;
+    }
+    printf("%ld positions analyzed at depth %d in %.2f s using %d threads (%lld nodes).\n",
+           job.uniqueAmt, depth, elapsed, threadAmt, job.nodes);
+ 
+    // write every game, one line each
+    FILE *file = fopen(outPath, "w");
+    long gameIndex = 0;
+    posIndex = 0;
+    offset = ARCHIVE_HEADER_SIZE;
+    while (file != NULL && readArchiveGame(data, size, &offset, &record)) {
+        initGameData(&game);
+        fprintf(file, "{\"game\":%ld,\"result\":%d,\"plies\":[", gameIndex, record.result);
+ 
+        for (int i = 0; i < record.plyAmt; i++) {
+            long before = uniqueIndexes[posIndex + i];
+            long after = uniqueIndexes[posIndex + i + 1];
+            char played[8] = "";
+            char best[8] = "";
+            Move move;
+ 
+            if (job.bestCodes[before] != -1 && decodeMove(&game, job.bestCodes[before], &move)) {
+                formatMove(move, best);
+            }
+            decodeMove(&game, record.moves[i], &move);
+            formatMove(move, played);
+ 
+            int loss = job.scores[before] - job.scores[after];
+            if (game.curPlayer == 2) {
+                loss = -loss;
+            }
+            fprintf(file, "%s{\"ply\":%d,\"move\":\"%s\",\"best\":\"%s\",\"eval\":%d,\"after\":%d,\"mark\":\"%s\"}",
+                    i > 0 ? "," : "", i + 1, played, best, job.scores[before], job.scores[after],
+                    strcmp(played, best) == 0 ? "best" : getMoveMark(loss));
+            applyMove(&game, move);
+        }
+ 
+        fprintf(file, "]}\n");
+        posIndex += record.plyAmt + 1;
+        gameIndex++;
+    }
+ 
+    int failed = file == NULL || fclose(file) != 0;
+    if (failed) {
+        printf("ERROR: Could not write %s!\n", outPath);
+    } else {
+        printf("%ld annotated games written to %s.\n", gameIndex, outPath);
+    }
+ 
+    freeTransTable(&table);
+    free(job.unique);
+    free(job.bestCodes);
+    free(job.scores);
+    free(uniqueIndexes);
+    closeArchive(data, size);
+    return failed;
+}
+ 
+/**
+ * @brief Plays random moves from the start until the game ends.
+ *
+ * @param pGame          Contains game data, which is reinitialized.
+ * @param pRandomState   The state of the random choices.
+ * @param stopPly        The ply at which to stop even if the game is ongoing
+ *                       (MAX_PLY to play the whole game).
+ *
+ * @return The amount of plies played.
+ */
+int playRandomGame(GameData *pGame, uint64_t *pRandomState, int stopPly) {
+    initGameData(pGame);
+    int plyAmt = 0;
+ 
+    while (plyAmt < stopPly && checkGameStatus(pGame) == GAME_ONGOING) {
+        Move moves[MAX_MOVE_AMT];
+        int moveAmt = generateMoves(pGame, moves);
+        if (moveAmt == 0) {
+            break;
+        }
+ 
+        applyMove(pGame, moves[nextRandom(pRandomState) % moveAmt]);
+        plyAmt++;
+    }
+ 
+    return plyAmt;
+}
+ 
+/**
+ * @brief Benchmarks generateMoves() over every benchmark position.
+ *
+ * @param pData        Contains the benchmark positions.
+ * @param pChecksum    Pointer to a checksum of the results.
+ *
+ * @return The amount of operations done.
+ */
+long benchGenerateMoves(BenchData *pData, uint64_t *pChecksum) {
+    Move moves[MAX_MOVE_AMT];
+    for (int i = 0; i < BENCH_POS_AMT; i++) {
+        *pChecksum += generateMoves(&pData->positions[i], moves);
+    }
+ 
+    return BENCH_POS_AMT;
+}
+ 
+/**
+ * @brief Benchmarks applyMove() over every move of every benchmark position.
+ *
+ * @param pData        Contains the benchmark positions and their moves.
+ * @param pChecksum    Pointer to a checksum of the results.
+ *
+ * @return The amount of operations done.
+ */
+long benchApplyMove(BenchData *pData, uint64_t *pChecksum) {
+    long opAmt = 0;
+    for (int i = 0; i < BENCH_POS_AMT; i++) {
+        for (int j = 0; j < pData->moveAmts[i]; j++) {
+            GameData child = pData->positions[i];
+            applyMove(&child, pData->moves[i][j]);
+            *pChecksum += child.alphaPosAmt * 8 + child.betaPosAmt;
+            opAmt++;
+        }
+    }
+ 
+    return opAmt;
+}
+ 
+/**
+ * @brief Benchmarks checkGameStatus() over every benchmark position.
+ *
+ * @param pData        Contains the benchmark positions.
+ * @param pChecksum    Pointer to a checksum of the results.
+ *
+ * @return The amount of operations done.
+ */
+long benchCheckGameStatus(BenchData *pData, uint64_t *pChecksum) {
+    for (int i = 0; i < BENCH_POS_AMT; i++) {
+        *pChecksum += checkGameStatus(&pData->positions[i]);
+    }
+ 
+    return BENCH_POS_AMT;
+}
+ 
+/**
+ * @brief Benchmarks packPos() and unpackPos() over every benchmark position.
+ *
+ * @param pData        Contains the benchmark positions.
+ * @param pChecksum    Pointer to a checksum of the results.
+ *
+ * @return The amount of operations done.
+ */
+long benchPackPos(BenchData *pData, uint64_t *pChecksum) {
+    GameData game = pData->positions[0];
+    for (int i = 0; i < BENCH_POS_AMT; i++) {
+        PackedPos packed = packPos(&pData->positions[i]);
+        unpackPos(packed, &game);
+        *pChecksum += hashPackedPos(packed) + (packPos(&game) == packed);
+    }
+ 
+    return BENCH_POS_AMT;
+}
+ 
+/**
+ * @brief Benchmarks displayBoard() with the standard output sent nowhere.
+ *
+ * @param pData        Contains the benchmark positions.
+ * @param pChecksum    Pointer to a checksum of the results.
+ *
+ * @return The amount of operations done.
+ */
+long benchDisplayBoard(BenchData *pData, uint64_t *pChecksum) {
+    fflush(stdout);
+    int stdoutFd = dup(STDOUT_FILENO);
+    int nullFd = open("/dev/null", O_WRONLY);
+    dup2(nullFd, STDOUT_FILENO);
+ 
+    for (int i = 0; i < BENCH_RENDER_AMT; i++) {
+        displayBoard(pData->positions[i % BENCH_POS_AMT].gameBoard);
+    }
+ 
+    fflush(stdout);
+    dup2(stdoutFd, STDOUT_FILENO);
+    close(nullFd);
+    close(stdoutFd);
+    *pChecksum += BENCH_RENDER_AMT;
+ 
+    return BENCH_RENDER_AMT;
+}
+ 
+/**
+ * @brief Benchmarks whole games of random moves.
+ *
+ * @param pData        Contains the seed of the games.
+ * @param pChecksum    Pointer to a checksum of the results.
+ *
+ * @return The amount of operations done.
+ */
+long benchRandomGame(BenchData *pData, uint64_t *pChecksum) {
+    uint64_t randomState = mixSeed(pData->seed);
+    GameData game;
+ 
+    for (int i = 0; i < BENCH_GAME_AMT; i++) {
+        *pChecksum += playRandomGame(&game, &randomState, MAX_PLY);
+    }
+ 
+    return BENCH_GAME_AMT;
+}
+ 
+/**
+ * @brief Benchmarks whole games of the computer against itself.
+ *
+ * @param pData        Contains the seed of the games.
+ * @param pChecksum    Pointer to a checksum of the results.
+ *
+ * @return The amount of operations done.
+ */
+long benchSelfPlayGame(BenchData *pData, uint64_t *pChecksum) {
+    SearchInfo *pInfo = &pData->search;
+    unsigned char codes[MAX_PLY];
+    int result = GAME_ONGOING;
+    pInfo->useOrdering = 1;
+    pInfo->pTable = NULL;
+ 
+    for (int i = 0; i < BENCH_SELFPLAY_AMT; i++) {
+        *pChecksum += playSelfPlayGame(mixSeed(pData->seed ^ (uint64_t) i), 2, pInfo, codes, &result);
+    }
+ 
+    return BENCH_SELFPLAY_AMT;
+}
+ 
+/**
+ * @brief Pins the program to a single processor to reduce timing variance.
+ * @details
+ *    The first processor that the program is allowed to run on is chosen, so
+ *    pinning also works when the program is restricted to some processors.
+ *
+ * @note Only supported on Linux. Elsewhere, nothing is done.
+ *
+ * @return
+ *    1   if the program was pinned.
+ *    0   otherwise.
+ */
+int pinToCore(void) {
+#ifdef __linux__
+    cpu_set_t cpuSet;
+    if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) != 0) {
+        return 0;
+    }
+ 
+    for (int core = 0; core < CPU_SETSIZE; core++) {
+        if (CPU_ISSET(core, &cpuSet)) {
+            CPU_ZERO(&cpuSet);
+            CPU_SET(core, &cpuSet);
+            return sched_setaffinity(0, sizeof(cpuSet), &cpuSet) == 0;
+        }
+    }
+#endif
+ 
+    return 0;
+}
+ 
+/**
+ * @brief Runs the benchmarks of the rules primitives and whole games.
+ * @details
+ *    BENCH_POS_AMT positions are created by playing random moves from the
+ *    start with the given seed, so every run measures the same work. Each
+ *    benchmark is repeated BENCH_REPEAT_AMT times and the fastest repetition
+ *    is reported, along with a checksum of the results that must not change
+ *    between runs with the same seed.
+ *
+ *    The results are printed as JSON with one benchmark per line, in a fixed
+ *    order and format.
+ *
+ * @param seed   The seed of the benchmark positions and games.
+ *
+ * @return
+ *    0   if the benchmarks were run.
+ *    1   otherwise.
+ */
+int runBenchmarks(uint64_t seed) {
+    BenchData *pData = malloc(sizeof(*pData));
+    if (pData == NULL) {
+        return 1;
+    }
+ 
+    int pinned = pinToCore();
+    uint64_t randomState = mixSeed(seed);
+    pData->seed = seed;
+    for (int i = 0; i < BENCH_POS_AMT; i++) {
+        // stop at a random ply, and start over if the game ended before then
+        do {
+            playRandomGame(&pData->positions[i], &randomState, nextRandom(&randomState) % 40);
+        } while (checkGameStatus(&pData->positions[i]) != GAME_ONGOING);
+        pData->moveAmts[i] = generateMoves(&pData->positions[i], pData->moves[i]);
+    }
+ 
+    char *names[] = {"generateMoves", "applyMove", "checkGameStatus", "displayBoard",
+                     "randomGame", "selfPlayGame", "packUnpackPos"};
+    long (*functions[])(BenchData *, uint64_t *) = {benchGenerateMoves, benchApplyMove,
+        benchCheckGameStatus, benchDisplayBoard, benchRandomGame, benchSelfPlayGame,
+        benchPackPos};
+    int benchAmt = sizeof(functions) / sizeof(functions[0]);
+ 
+    printf("{\"benchmark\":\"SimpleCheckers\",\"version\":1,\"seed\":%llu,\"pinned\":%s,\"results\":[\n",
+           (unsigned long long) seed, pinned ? "true" : "false");
+    for (int i = 0; i < benchAmt; i++) {
+        double bestTime = 0;
+        long opAmt = 0;
+        uint64_t checksum = 0;
+ 
+        for (int j = 0; j < BENCH_REPEAT_AMT; j++) {
+            checksum = 0;
+            double startTime = getTime();
+            opAmt = functions[i](pData, &checksum);
+            double elapsed = getTime() - startTime;
+            if (j == 0 || elapsed < bestTime) {
+                bestTime = elapsed;
+            }
+        }
+ 
+        printf("  {\"name\":\"%s\",\"ops\":%ld,\"ns_per_op\":%.2f,\"ops_per_sec\":%.0f,\"checksum\":%llu}%s\n",
+               names[i], opAmt, bestTime * 1e9 / opAmt, opAmt / bestTime,
+               (unsigned long long) checksum, i < benchAmt - 1 ? "," : "");
+    }
+    printf("]}\n");
+ 
+    free(pData);
+    return 0;
+}
+ 
+/**
+ * @brief Prompts the player to select a piece that they will move.
+ *
+ * @param pGame   Contains game data.
+ * @param row     Pointer to where the row value of the chosen position will
+ *                be stored.
+ * @param col     Pointer to where the column value of the chosen position
+ *                will be stored.
+ *
+ * @return
+ *    1   if the player selected a piece.
+ *    0   if the input ended.
+ */
+int playerSelectPiece(GameData *pGame, int *row, int *col) {
+    int inputIsValid = 0;
+    int posIsAvailable = 0;
+ 
+    while (!inputIsValid) {
+        printf("%s: Select a piece to move.\n",
+                pGame->curPlayer == 1 ? "Alpha" : "Beta");
+        Pos temp = {0};
+        if (getUserInput(&temp.row, &temp.col) == 0) {
+            return 0;
+        }
+        posIsAvailable = isPosAvailable(pGame, temp);
+ 
+        // player must select a square that contains one of their pieces
+        if (posIsAvailable == 0) {
+            *row = temp.row;
+            *col = temp.col;
+            inputIsValid = 1;
+        } else {
+            printf("ERROR: You must select a piece of yours!\n");
+            discardUserInput();
+        }
+        printf("\n");
+    }
+ 
+    return 1;
 }
  
 /**
@@ -932,6 +5861,7 @@ void playerSelectPiece(GameData *pGame, int *row, int *col) {
  * @return
  *    1   if the player's move is just to move a piece.
  *    2   if the player's move is to capture an opponent's piece.
+ *    0   if the input ended.
  */
 int playerMovePiece(GameData *pGame, Pos srcPos, Pos *destPos) {
     int inputIsValid = 0;
@@ -940,10 +5870,13 @@ int playerMovePiece(GameData *pGame, Pos srcPos, Pos *destPos) {
     while (!inputIsValid) {
         printf("%s: Select a square to move your selected piece to.\n",
                 pGame->curPlayer == 1 ? "Alpha" : "Beta");
-        getUserInput(&destPos->row, &destPos->col);
+        if (getUserInput(&destPos->row, &destPos->col) == 0) {
+            return 0;
+        }
  
         // ask the player for input again if their move is not legal
         if (isMoveLegal(pGame->curPlayer, srcPos, *destPos) == 0) {
+            discardUserInput();
             printf("ERROR: You can only move one square forward, ");
             printf("either directly forward or diagonally!\n\n");
             continue;
@@ -960,6 +5893,7 @@ int playerMovePiece(GameData *pGame, Pos srcPos, Pos *destPos) {
             if (posIsAvailable == 2) {
                 if (isSquareS(*destPos) == 0) {
                     printf("ERROR: You can only capture pieces in S squares!\n");
+                    discardUserInput();
                     inputIsValid = 0;
                 }
             }
@@ -967,6 +5901,7 @@ int playerMovePiece(GameData *pGame, Pos srcPos, Pos *destPos) {
         // player cannot select a square occupied by one of their pieces
         } else {
             printf("ERROR: You can't capture your own pieces!\n");
+            discardUserInput();
             inputIsValid = 0;
         }
         printf("\n");
@@ -975,6 +5910,342 @@ int playerMovePiece(GameData *pGame, Pos srcPos, Pos *destPos) {
     return posIsAvailable;
 }
  
+/**
+ * @brief Clears the screen, but only if the output is shown in a terminal.
+ *
+ * @note
+ *    Clearing the screen starts a shell, which is skipped when the output is
+ *    redirected (ex. when a move script is played) since it is not needed.
+ */
+void clearScreen(void) {
+    if (isatty(STDOUT_FILENO)) {
+        system("cls");
+    }
+}
+ 
+/**
+ * @brief Lets the computer choose and execute the current player's move.
+ * @details
+ *    If enabled, proof-number search first tries to prove a forced win
+ *    within a small node budget, in which case the winning move is played
+ *    without searching. Otherwise, the best move is searched for.
+ *
+ * @param pGame      Contains game data.
+ * @param pOptions   Contains the options of the game.
+ *
+ * @return
+ *    1   if a move was played.
+ *    0   if the current player has no moves, or the search state could not
+ *        be reserved.
+ */
+int aiMovePiece(GameData *pGame, PlayOptions *pOptions) {
+    Move move = {{0, 0}, {0, 0}, 0};
+    Solver solver;
+    int result = PN_UNKNOWN;
+ 
+    if (pOptions->aiUseSolver && initSolver(&solver, (size_t) PN_AI_TABLE_MB << 20)) {
+        solver.maxNodes = PN_AI_NODE_AMT;
+        result = proveWin(&solver, pGame, pGame->curPlayer, &move);
+        freeSolver(&solver);
+    }
+ 
+    if (result == PN_WIN) {
+        printf("%s has a forced win.\n", pGame->curPlayer == 1 ? "Alpha" : "Beta");
+    } else {
+        SearchInfo *pInfo = malloc(sizeof(*pInfo));
+        if (pInfo == NULL) {
+            printf("ERROR: Could not reserve the search state!\n");
+            return 0;
+        }
+        pInfo->useOrdering = 1;
+        pInfo->pTable = gSharedTable;
+        int moveAmt = searchBestMove(pGame, pOptions->aiDepth, pInfo, &move);
+        free(pInfo);
+        if (moveAmt == 0) {
+            return 0;
+        }
+    }
+ 
+    printf("%s moves %c%d to %c%d.\n\n", pGame->curPlayer == 1 ? "Alpha" : "Beta",
+           intColToCharCol(move.src.col), move.src.row,
+           intColToCharCol(move.dest.col), move.dest.row);
+ 
+    if (move.type == 1) {
+        movePiece(pGame, move.src, move.dest);
+    } else {
+        capturePiece(pGame, move.src, move.dest);
+    }
+ 
+    return 1;
+}
+ 
+/**
+ * @brief Starts broadcasting a game to spectators.
+ * @details
+ *    The broadcast is a ring of board diffs in named shared memory, along
+ *    with a snapshot of the whole board. A broadcast left over from an
+ *    earlier game with the same name is replaced.
+ *
+ * @param pBroadcast   The broadcast to be started.
+ * @param name         The name of the broadcast (ex. /scga-live).
+ * @param pGame        Contains the game data at the start of the game.
+ *
+ * @return
+ *    1   if the broadcast was started.
+ *    0   otherwise.
+ */
+int openBroadcast(Broadcaster *pBroadcast, char name[], GameData *pGame) {
+    shm_unlink(name);
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd == -1) {
+        return 0;
+    }
+ 
+    BroadcastRing *pRing = MAP_FAILED;
+    if (ftruncate(fd, sizeof(BroadcastRing)) == 0) {
+        pRing = mmap(NULL, sizeof(BroadcastRing), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (pRing == MAP_FAILED) {
+        shm_unlink(name);
+        return 0;
+    }
+ 
+    // the ring is only marked ready once the snapshot is written
+    pRing->version = BROADCAST_VERSION;
+    pRing->row = ROW;
+    pRing->col = COL;
+    pRing->snapshot.curPlayer = (uint8_t) pGame->curPlayer;
+    memcpy(pRing->snapshot.board, pGame->gameBoard, sizeof(pGame->gameBoard));
+    __atomic_store_n(&pRing->magic, BROADCAST_MAGIC, __ATOMIC_RELEASE);
+ 
+    pBroadcast->pRing = pRing;
+    pBroadcast->name = name;
+    pBroadcast->ply = 0;
+    memcpy(pBroadcast->board, pGame->gameBoard, sizeof(pGame->gameBoard));
+    return 1;
+}
+ 
+/**
+ * @brief Publishes the squares that the last move changed to the spectators
+ *        of a game.
+ * @details
+ *    The diff is written to the next slot of the ring, overwriting the
+ *    oldest one, and the snapshot is updated after it. Each is guarded by
+ *    a sequence number that spectators check before and after reading, so
+ *    the game never waits for them: a spectator that falls a whole ring
+ *    behind finds its next diff overwritten and resyncs from the snapshot
+ *    instead (see runSpectator()).
+ *
+ * @param pBroadcast   The broadcast of the game.
+ * @param pGame        Contains the game data after the move.
+ * @param result       The status of the game after the move, or
+ *                     BROADCAST_NO_MOVES (published without a move) if the
+ *                     player to move has no moves left.
+ */
+void publishBoard(Broadcaster *pBroadcast, GameData *pGame, int result) {
+    BroadcastRing *pRing = pBroadcast->pRing;
+    BoardDiff diff = {++pBroadcast->ply, (uint8_t) result, (uint8_t) pGame->curPlayer, 0, {0}, {0}};
+ 
+    for (int i = 1; i <= ROW; i++) {
+        for (int j = 1; j <= COL; j++) {
+            if (pGame->gameBoard[i][j] == pBroadcast->board[i][j]) {
+                continue;
+            }
+            // a diff too large for a slot makes spectators read the snapshot
+            if (diff.changeAmt < BROADCAST_CHANGE_AMT) {
+                Pos square = {i, j};
+                diff.squares[diff.changeAmt] = (uint8_t) posToIndex(square);
+                diff.marks[diff.changeAmt] = pGame->gameBoard[i][j];
+            }
+            diff.changeAmt++;
+            pBroadcast->board[i][j] = pGame->gameBoard[i][j];
+        }
+    }
+ 
+    BroadcastSlot *pSlot = &pRing->slots[diff.ply % BROADCAST_SLOT_AMT];
+    __atomic_store_n(&pSlot->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    pSlot->diff = diff;
+    __atomic_store_n(&pSlot->seq, diff.ply, __ATOMIC_RELEASE);
+ 
+    // the snapshot's sequence number is odd while it is being written
+    uint64_t snapshotSeq = pRing->snapshotSeq;
+    __atomic_store_n(&pRing->snapshotSeq, snapshotSeq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    pRing->snapshot.ply = diff.ply;
+    pRing->snapshot.result = diff.result;
+    pRing->snapshot.curPlayer = diff.curPlayer;
+    memcpy(pRing->snapshot.board, pBroadcast->board, sizeof(pBroadcast->board));
+    __atomic_store_n(&pRing->snapshotSeq, snapshotSeq + 2, __ATOMIC_RELEASE);
+ 
+    __atomic_store_n(&pRing->head, diff.ply, __ATOMIC_RELEASE);
+}
+ 
+/**
+ * @brief Ends the broadcast of a game.
+ * @details
+ *    Spectators that are watching are told that the broadcast is over, and
+ *    its name is removed so that no more can join.
+ *
+ * @param pBroadcast   The broadcast to be ended.
+ */
+void closeBroadcast(Broadcaster *pBroadcast) {
+    __atomic_store_n(&pBroadcast->pRing->closed, 1, __ATOMIC_RELEASE);
+    munmap(pBroadcast->pRing, sizeof(BroadcastRing));
+    shm_unlink(pBroadcast->name);
+    pBroadcast->pRing = NULL;
+}
+ 
+/**
+ * @brief Reads the snapshot of a broadcast, retrying while the game is
+ *        writing it.
+ *
+ * @param pRing        The ring of the broadcast.
+ * @param pSnapshot    Where the snapshot is copied to.
+ */
+void readBroadcastSnapshot(BroadcastRing *pRing, BoardSnapshot *pSnapshot) {
+    uint64_t seq1;
+    uint64_t seq2;
+    do {
+        seq1 = __atomic_load_n(&pRing->snapshotSeq, __ATOMIC_ACQUIRE);
+        memcpy(pSnapshot, &pRing->snapshot, sizeof(*pSnapshot));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        seq2 = __atomic_load_n(&pRing->snapshotSeq, __ATOMIC_RELAXED);
+    } while (seq1 != seq2 || seq1 % 2 == 1);
+}
+ 
+/**
+ * @brief Reads a diff from the ring of a broadcast.
+ *
+ * @param pRing   The ring of the broadcast.
+ * @param ply     The number of the diff to be read.
+ * @param pDiff   Where the diff is copied to.
+ *
+ * @pre   The diff was published (ply <= pRing->head).
+ *
+ * @return
+ *    1   if the diff was read.
+ *    0   if the game already overwrote it.
+ */
+int readBroadcastDiff(BroadcastRing *pRing, uint64_t ply, BoardDiff *pDiff) {
+    BroadcastSlot *pSlot = &pRing->slots[ply % BROADCAST_SLOT_AMT];
+    uint64_t seq1 = __atomic_load_n(&pSlot->seq, __ATOMIC_ACQUIRE);
+    memcpy(pDiff, &pSlot->diff, sizeof(*pDiff));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    uint64_t seq2 = __atomic_load_n(&pSlot->seq, __ATOMIC_RELAXED);
+    return seq1 == ply && seq2 == ply;
+}
+ 
+/**
+ * @brief Watches a game broadcast by another process (see --broadcast).
+ * @details
+ *    Only the squares that each move changed are read from the broadcast,
+ *    and they are applied to a board of the spectator's own, which is then
+ *    displayed. A spectator that falls so far behind that the diffs it
+ *    needs were overwritten skips to the snapshot of the whole board. The
+ *    game has ended once a player won or the player to move has no moves
+ *    left (BROADCAST_NO_MOVES).
+ *
+ * @param name      The name of the broadcast.
+ * @param delayMs   Milliseconds to wait after each move is displayed, to
+ *                  follow the game slowly.
+ *
+ * @return
+ *    0   if the game was watched until it ended.
+ *    1   otherwise.
+ */
+int runSpectator(char name[], int delayMs) {
+    struct stat fileStat;
+    BroadcastRing *pRing = MAP_FAILED;
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd != -1 && fstat(fd, &fileStat) == 0 && fileStat.st_size == sizeof(BroadcastRing)) {
+        pRing = mmap(NULL, sizeof(BroadcastRing), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    if (fd != -1) {
+        close(fd);
+    }
+    if (pRing == MAP_FAILED) {
+        printf("ERROR: There is no broadcast named %s!\n", name);
+        return 1;
+    }
+    if (__atomic_load_n(&pRing->magic, __ATOMIC_ACQUIRE) != BROADCAST_MAGIC ||
+        pRing->version != BROADCAST_VERSION || pRing->row != ROW || pRing->col != COL) {
+        printf("ERROR: %s is not a broadcast of this version of the game!\n", name);
+        munmap(pRing, sizeof(BroadcastRing));
+        return 1;
+    }
+ 
+    BoardSnapshot view;
+    BoardDiff diff;
+    long resyncAmt = 0;
+    int synced = 0;
+    uint64_t ply = 0;
+    char changes[BROADCAST_CHANGE_AMT * 5 + 1] = "";
+ 
+    while (!synced || view.result == GAME_ONGOING) {
+        uint64_t head = __atomic_load_n(&pRing->head, __ATOMIC_ACQUIRE);
+        if (synced && head == ply) {
+            if (__atomic_load_n(&pRing->closed, __ATOMIC_ACQUIRE) &&
+                head == __atomic_load_n(&pRing->head, __ATOMIC_ACQUIRE)) {
+                break;
+            }
+            usleep(BROADCAST_POLL_US);
+            continue;
+        }
+ 
+        if (synced && readBroadcastDiff(pRing, ply + 1, &diff) && diff.changeAmt <= BROADCAST_CHANGE_AMT) {
+            // apply the diff to the spectator's board
+            int length = 0;
+            changes[0] = '\0';
+            for (int i = 0; i < diff.changeAmt; i++) {
+                int row = diff.squares[i] / COL_INIT;
+                int col = diff.squares[i] % COL_INIT;
+                view.board[row][col] = diff.marks[i];
+                length += sprintf(changes + length, " %c%d", intColToCharCol(col), row);
+            }
+            view.ply = diff.ply;
+            view.result = diff.result;
+            view.curPlayer = diff.curPlayer;
+        } else {
+            resyncAmt += synced;
+            readBroadcastSnapshot(pRing, &view);
+            changes[0] = '\0';
+            synced = 1;
+        }
+        ply = view.ply;
+ 
+        clearScreen();
+        displayBoard(view.board);
+        if (view.result == BROADCAST_NO_MOVES) {
+            printf("\n%s has no moves left.\n", view.curPlayer == 1 ? "Alpha" : "Beta");
+        } else if (view.ply == 0) {
+            printf("\nWaiting for the first move.\n");
+        } else if (changes[0] == '\0') {
+            printf("\nCaught up to move %u.\n", (unsigned) view.ply);
+        } else {
+            printf("\nMove %u changed%s.\n", (unsigned) view.ply, changes);
+        }
+        if (view.result == GAME_ONGOING) {
+            printf("%s to move.\n", view.curPlayer == 1 ? "Alpha" : "Beta");
+        }
+        fflush(stdout);
+        usleep((useconds_t) delayMs * 1000);
+    }
+ 
+    int over = view.result;
+    if (over == GAME_ONGOING) {
+        printf("The broadcast ended before the game did.\n");
+    } else if (over == BROADCAST_NO_MOVES) {
+        printf("%s has no moves left, so nobody wins.\n", view.curPlayer == 1 ? "Alpha" : "Beta");
+    } else {
+        printf("%s has won!\n", over == ALPHA_WIN ? "Alpha" : "Beta");
+    }
+    printf("Resynced from the snapshot %ld times.\n", resyncAmt);
+    munmap(pRing, sizeof(BroadcastRing));
+    return over == GAME_ONGOING;
+}
+ 
 /**
  * @brief Executes the main game.
  * @details
@@ -992,48 +6263,273 @@ int playerMovePiece(GameData *pGame, Pos srcPos, Pos *destPos) {
  *    7. The game goes on until either Alpha or Beta has no more pieces,
  *       or one has all their remaining pieces on the opponent's starting
  *       positions.
+ *
+ *    If a player is controlled by the computer, steps 2 to 5 are replaced by
+ *    a search for the best move (see aiMovePiece()). If the input ends (ex.
+ *    a move script was piped in), the game is stopped, and if the current
+ *    player has no moves, the game ends without a winner. If the game is
+ *    broadcast, the squares each move changed are published to spectators
+ *    (see publishBoard()).
+ *
+ * @param pOptions   Contains the options of the game.
  */
-void playGame(void) {
+void playGame(PlayOptions *pOptions) {
     GameData game;
     GameData *pGame = &game;
     initGameData(pGame);
  
+    Broadcaster broadcast = {0};
+    if (pOptions->broadcastName != NULL && openBroadcast(&broadcast, pOptions->broadcastName, pGame) == 0) {
+        printf("ERROR: Could not start the broadcast %s!\n", pOptions->broadcastName);
+        return;
+    }
+ 
     Pos srcPos = {0};
     Pos destPos = {0};
     int moveType = 0;
     int over = GAME_ONGOING;
+    int inputEnded = 0;
+    int noMovesLeft = 0;
+    int aiFailed = 0;
+    Move moves[MAX_MOVE_AMT];
  
-    system("cls");
+    clearScreen();
    
-    while (over == GAME_ONGOING) {
+    while (over == GAME_ONGOING && !inputEnded && !aiFailed) {
+        // as in self-play, the game ends without a winner if the current player cannot move
+        if (generateMoves(pGame, moves) == 0) {
+            noMovesLeft = 1;
+            break;
+        }
+ 
         displayInstructions();
         displayBoard(pGame->gameBoard);
-        // debug_showABPos(pGame); // uncomment when debugging
+        PROFILE_STATS("turn");
         printf("\n\n");
-        playerSelectPiece(pGame, &srcPos.row, &srcPos.col);
-        moveType = playerMovePiece(pGame, srcPos, &destPos);
  
-        // change the board depending on whether the player decided to move
-        // or capture a piece
-        if (moveType == 1) {
-            movePiece(pGame, srcPos, destPos);
+        if (pGame->curPlayer == pOptions->aiPlayer) {
+            if (aiMovePiece(pGame, pOptions) == 0) {
+                aiFailed = 1;
+                continue;
+            }
         } else {
-            capturePiece(pGame, srcPos, destPos);
+            moveType = 0;
+            if (playerSelectPiece(pGame, &srcPos.row, &srcPos.col) == 1) {
+                moveType = playerMovePiece(pGame, srcPos, &destPos);
+            }
+ 
+            // change the board depending on whether the player decided to move
+            // or capture a piece
+            if (moveType == 1) {
+                movePiece(pGame, srcPos, destPos);
+            } else if (moveType == 2) {
+                capturePiece(pGame, srcPos, destPos);
+            } else {
+                inputEnded = 1;
+                continue;
+            }
         }
  
         over = checkGameStatus(pGame);
         pGame->curPlayer = switchPlayer(pGame->curPlayer);
+        if (broadcast.pRing != NULL) {
+            publishBoard(&broadcast, pGame, over);
+        }
  
-        system("cls");
+        clearScreen();
     }
 
     displayInstructions();
     displayBoard(pGame->gameBoard); // update board to reflect latest move
-    printf("%s has won!\n", over == ALPHA_WIN ? "Alpha" : "Beta");
+    if (noMovesLeft) {
+        printf("%s has no moves left, so nobody wins.\n", pGame->curPlayer == 1 ? "Alpha" : "Beta");
+        if (broadcast.pRing != NULL) {
+            publishBoard(&broadcast, pGame, BROADCAST_NO_MOVES);
+        }
+    } else if (aiFailed) {
+        printf("The computer could not move, so the game was stopped.\n");
+    } else if (over == GAME_ONGOING) {
+        printf("The input ended before the game did.\n");
+    } else {
+        printf("%s has won!\n", over == ALPHA_WIN ? "Alpha" : "Beta");
+    }
+ 
+    if (broadcast.pRing != NULL) {
+        closeBroadcast(&broadcast);
+    }
+}
+ 
+/**
+ * @brief Prints how the program can be run.
+ *
+ * @param program   The name the program was run with.
+ */
+void printUsage(char program[]) {
+    printf("Usage: %s [--memory <MiB>] [--checkpoint <seconds>] [--rules <S>:<rows>:<pieces>]\n", program);
+    printf("       [--shared-table <name>] [--huge-pages] [mode]\n");
+    printf("  %s                        play a two-player game\n", program);
+    printf("  %s --ai [depth]           play as Alpha against the computer\n", program);
+    printf("      (--no-solve skips looking for a forced win first)\n");
+    printf("  %s --script <file> [...]  play the moves in a file first, then read from input\n", program);
+    printf("  %s --broadcast <name> [...] let spectators watch the game (can be combined with the above)\n",
+           program);
+    printf("  %s --spectate <name> [delay] watch a game broadcast by another process\n", program);
+    printf("  %s --search-bench [depth] count search nodes with and without move ordering\n", program);
+    printf("  %s --selfplay <games> <archive> [depth] [seed]\n", program);
+    printf("      play games of the computer against itself and save them\n");
+    printf("  %s --tune <archive> [threads] [epochs]\n", program);
+    printf("      fit the evaluation weights to the results of archived games\n");
+    printf("  %s --validate <archive> [verdicts]\n", program);
+    printf("      check that every archived game follows the rules\n");
+    printf("  %s --annotate <archive> <output> [depth]\n", program);
+    printf("      mark every move of every archived game as best, inaccuracy or blunder\n");
+    printf("  %s --solve [moves] [nodes] [seconds]\n", program);
+    printf("      prove a win or loss after the given moves (ex. \"B6-B5 B2-B3\")\n");
+    printf("  %s --compress <archive> <output>\n", program);
+    printf("      compress an archive of valid games with a range coder\n");
+    printf("  %s --decompress <input> <archive>\n", program);
+    printf("      decompress an archive written by --compress\n");
+    printf("  %s --stats <archive> [...]\n", program);
+    printf("      print win rates, game lengths, captures and win conditions\n");
+    printf("  %s --sweep <games> [depth] [seed]\n", program);
+    printf("      compare the balance of variants of the rules with self-play and the solver\n");
+    printf("  %s --bench [seed]         benchmark the rules and whole games (JSON output)\n", program);
+    printf("  %s --remove-table <name>  remove a table made by --shared-table\n", program);
+}
+ 
+/**
+ * @brief Reads a search depth from the arguments of a mode.
+ * @details
+ *    The search keeps killer moves per ply, so the depth must be from 1 to
+ *    MAX_PLY.
+ *
+ * @param argc           The amount of arguments.
+ * @param argv           The arguments.
+ * @param index          The index of the depth in argv.
+ * @param defaultDepth   The depth if the argument was not given.
+ *
+ * @return
+ *    The depth   if it is valid.
+ *    0           otherwise (an error is printed).
+ */
+int parseDepth(int argc, char *argv[], int index, int defaultDepth) {
+    int depth = index < argc ? atoi(argv[index]) : defaultDepth;
+    if (depth < 1 || depth > MAX_PLY) {
+        printf("ERROR: The depth must be from 1 to %d!\n", MAX_PLY);
+        return 0;
+    }
+ 
+    return depth;
 }
  
-int main(void) {
-    playGame();
+int main(int argc, char *argv[]) {
+    PlayOptions options = {0, 6, 1, NULL};
+    char *tableName = NULL;
+    int useHugePages = 0;
+ 
+    // the memory budget, checkpoints, rules and table apply to every mode, so they are taken out first
+    while ((argc > 1 && strcmp(argv[1], "--huge-pages") == 0) ||
+           (argc > 2 && (strcmp(argv[1], "--memory") == 0 || strcmp(argv[1], "--checkpoint") == 0 ||
+                         strcmp(argv[1], "--rules") == 0 || strcmp(argv[1], "--shared-table") == 0))) {
+        if (strcmp(argv[1], "--huge-pages") == 0) {
+            useHugePages = 1;
+            argv[1] = argv[0];
+            argv++;
+            argc--;
+            continue;
+        } else if (strcmp(argv[1], "--memory") == 0) {
+            gMemoryBudget = (size_t) atol(argv[2]) << 20;
+        } else if (strcmp(argv[1], "--checkpoint") == 0) {
+            gCheckpointInterval = atof(argv[2]);
+        } else if (strcmp(argv[1], "--shared-table") == 0) {
+            tableName = argv[2];
+        } else if (parseRules(argv[2], &gRules) == 0) {
+            printf("ERROR: %s are not valid rules (ex. same:2:5)!\n", argv[2]);
+            return 1;
+        }
+        argv[2] = argv[0];
+        argv += 2;
+        argc -= 2;
+    }
+ 
+    // the table is sized by the memory budget, so it is opened once every option is read
+    TransTable sharedTable;
+    if (tableName != NULL) {
+        if (openSharedTransTable(&sharedTable, tableName, gMemoryBudget, useHugePages) == 0) {
+            printf("ERROR: Could not open the shared table %s!\n", tableName);
+            return 1;
+        }
+        gSharedTable = &sharedTable;
+    }
+ 
+#ifdef ENABLE_PROFILING
+    startProfiling();
+#endif
+ 
+    if (argc == 1 || strcmp(argv[1], "--ai") == 0 || strcmp(argv[1], "--script") == 0 ||
+        strcmp(argv[1], "--broadcast") == 0) {
+        for (int i = 1; i < argc; i++) {
+            if (strcmp(argv[i], "--ai") == 0) {
+                options.aiPlayer = 2;
+                if (i + 1 < argc && (isdigit((unsigned char) argv[i + 1][0]) || argv[i + 1][0] == '-')) {
+                    options.aiDepth = parseDepth(argc, argv, ++i, 0);
+                    if (options.aiDepth == 0) {
+                        return 1;
+                    }
+                }
+            } else if (strcmp(argv[i], "--no-solve") == 0) {
+                options.aiUseSolver = 0;
+            } else if (strcmp(argv[i], "--broadcast") == 0 && i + 1 < argc) {
+                options.broadcastName = argv[++i];
+            } else if (strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+                gInput.script = fopen(argv[++i], "r");
+                if (gInput.script == NULL) {
+                    printf("ERROR: Could not open %s!\n", argv[i]);
+                    return 1;
+                }
+            } else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        playGame(&options);
+    } else if (strcmp(argv[1], "--search-bench") == 0) {
+        int depth = parseDepth(argc, argv, 2, 8);
+        if (depth == 0) {
+            return 1;
+        }
+        return runSearchBench(depth);
+    } else if (strcmp(argv[1], "--selfplay") == 0 && argc > 3) {
+        int depth = parseDepth(argc, argv, 4, 2);
+        return depth == 0 ? 1 : runSelfPlay(atol(argv[2]), argv[3], depth, argc > 5 ? strtoull(argv[5], NULL, 10) : 1);
+    } else if (strcmp(argv[1], "--tune") == 0 && argc > 2) {
+        return runTuner(argv[2], argc > 3 ? atoi(argv[3]) : 0, argc > 4 ? atoi(argv[4]) : 500);
+    } else if (strcmp(argv[1], "--validate") == 0 && argc > 2) {
+        return runValidator(argv[2], argc > 3 ? argv[3] : NULL);
+    } else if (strcmp(argv[1], "--annotate") == 0 && argc > 3) {
+        int depth = parseDepth(argc, argv, 4, 6);
+        return depth == 0 ? 1 : runAnnotator(argv[2], argv[3], depth);
+    } else if (strcmp(argv[1], "--solve") == 0) {
+        return runSolver(argc > 2 ? argv[2] : "", argc > 3 ? atoll(argv[3]) : 0, argc > 4 ? atof(argv[4]) : 0);
+    } else if (strcmp(argv[1], "--compress") == 0 && argc > 3) {
+        return runCompressor(argv[2], argv[3]);
+    } else if (strcmp(argv[1], "--decompress") == 0 && argc > 3) {
+        return runDecompressor(argv[2], argv[3]);
+    } else if (strcmp(argv[1], "--stats") == 0 && argc > 2) {
+        return runStats(argv + 2, argc - 2);
+    } else if (strcmp(argv[1], "--sweep") == 0 && argc > 2) {
+        int depth = parseDepth(argc, argv, 3, 2);
+        return depth == 0 ? 1 : runSweep(atol(argv[2]), depth, argc > 4 ? strtoull(argv[4], NULL, 10) : 1);
+    } else if (strcmp(argv[1], "--spectate") == 0 && argc > 2) {
+        return runSpectator(argv[2], argc > 3 ? atoi(argv[3]) : 0);
+    } else if (strcmp(argv[1], "--remove-table") == 0 && argc > 2) {
+        return removeSharedTransTable(argv[2]);
+    } else if (strcmp(argv[1], "--bench") == 0) {
+        return runBenchmarks(argc > 2 ? strtoull(argv[2], NULL, 10) : 1);
+    } else {
+        printUsage(argv[0]);
+        return 1;
+    }
  
     return 0;
 }
\ No newline at end of file